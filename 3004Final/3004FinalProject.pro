@@ -1,6 +1,6 @@
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent svg
 
 CONFIG += c++11
 
@@ -10,27 +10,98 @@ CONFIG += c++11
 # deprecated API in order to know how to port your code away from it.
 DEFINES += QT_DEPRECATED_WARNINGS
 
+# Build with "qmake CONFIG+=tracing" to compile in the event tracer (enabled at run time with --trace <file>).
+tracing: DEFINES += HRV_TRACING
+
+# Build with "qmake CONFIG+=fixed_point" to score coherence with the integer only engine meant for low-power hardware.
+fixed_point: DEFINES += HRV_FIXED_POINT
+
+# Build with "qmake CONFIG+=alloc_count" to count every heap allocation for the allocation figures of --compare-coherence. This replaces
+# the process's allocator with a counting one, so it is left out of the default build.
+alloc_count: DEFINES += HRV_COUNT_ALLOCATIONS
+
 # You can also make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    ./src/allocationcounter.cpp \
+    ./src/artifactfilter.cpp \
+    ./src/breathpacer.cpp \
+    ./src/coherencebench.cpp \
+    ./src/coherencecomparison.cpp \
+    ./src/coherenceengine.cpp \
+    ./src/dashboard.cpp \
+    ./src/dashboardpipeline.cpp \
     ./src/datagen.cpp \
+    ./src/devicesnapshot.cpp \
+    ./src/fixedpointcoherenceengine.cpp \
+    ./src/floatcoherenceengine.cpp \
+    ./src/historyanalytics.cpp \
+    ./src/historyindex.cpp \
+    ./src/historylistmodel.cpp \
+    ./src/historystore.cpp \
+    ./src/hrvmetrics.cpp \
+    ./src/hrvplot.cpp \
     ./src/log.cpp \
     ./src/main.cpp \
     ./src/mainwindow.cpp \
+    ./src/powermodel.cpp \
     ./src/session.cpp \
+    ./src/sessionarena.cpp \
+    ./src/sessionexporter.cpp \
+    ./src/sessionjournal.cpp \
+    ./src/simclock.cpp \
+    ./src/soakharness.cpp \
+    ./src/streampublisher.cpp \
+    ./src/streamreader.cpp \
+    ./src/thresholdtuner.cpp \
+    ./src/tracer.cpp \
     ./src/profile.cpp \
+    ./src/profilemanager.cpp \
+    ./src/renderscheduler.cpp \
+    ./src/memorystats.cpp \
     ./src/menu.cpp
 
 HEADERS += \
+    ./src/allocationcounter.h \
+    ./src/artifactfilter.h \
+    ./src/breathpacer.h \
+    ./src/coherencebench.h \
+    ./src/coherencecomparison.h \
+    ./src/coherenceengine.h \
+    ./src/dashboard.h \
+    ./src/dashboardpipeline.h \
     ./src/datagen.h \
+    ./src/devicesnapshot.h \
+    ./src/fixedpointcoherenceengine.h \
+    ./src/floatcoherenceengine.h \
+    ./src/historyanalytics.h \
+    ./src/historyindex.h \
+    ./src/historylistmodel.h \
+    ./src/historystore.h \
+    ./src/hrvmetrics.h \
+    ./src/hrvplot.h \
     ./src/log.h \
     ./src/mainwindow.h \
+    ./src/memorystats.h \
     ./src/menu.h \
+    ./src/powermodel.h \
     ./src/profile.h \
-    ./src/session.h
+    ./src/profilemanager.h \
+    ./src/renderscheduler.h \
+    ./src/session.h \
+    ./src/sessionarena.h \
+    ./src/sessionexporter.h \
+    ./src/sessionjournal.h \
+    ./src/simclock.h \
+    ./src/soakharness.h \
+    ./src/streampublisher.h \
+    ./src/streamreader.h \
+    ./src/streamring.h \
+    ./src/thresholdtuner.h \
+    ./src/tracer.h
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,70 @@
+#include "allocationcounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//The number of allocations made since the process started.
+static std::atomic<quint64> allocationCount(0);
+
+//Getter methods
+bool AllocationCounter::isCompiledIn() {
+#ifdef HRV_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+quint64 AllocationCounter::getCount() {return allocationCount.load(std::memory_order_relaxed);}
+
+bool AllocationCounter::isCountingMalloc() {
+#if defined(HRV_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if defined(HRV_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+
+/*  glibc lets the executable replace the malloc family for every library it loads. The replacements count the call and forward it to
+    glibc's own allocator. operator new allocates with malloc, so it is counted too.*/
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    //Every realloc is counted since it may move the block to a new allocation.
+    void* realloc(void* pointer, size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer) {__libc_free(pointer);}
+}
+
+#elif defined(HRV_COUNT_ALLOCATIONS)
+
+/*  Without glibc only the global operator new is replaced. The array, nothrow and sized forms of the standard library call these two, so
+    they are counted as well.*/
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::malloc(size ? size : 1);
+    if(pointer == NULL) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {std::free(pointer);}
+
+#endif
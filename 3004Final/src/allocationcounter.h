@@ -0,0 +1,22 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+/*  The AllocationCounter class counts every heap allocation made by the process, so harnesses can check how many allocations a piece of
+    code makes. With glibc the malloc family itself is counted, which also sees the Qt containers (they allocate with malloc, not new).
+    Elsewhere only the global operator new is counted, so allocations made by Qt containers are missed there.
+
+    Counting costs an atomic increment of one shared counter on every allocation of every thread, so the counting allocator is only
+    compiled in when building with "qmake CONFIG+=alloc_count". Otherwise nothing is replaced and getCount() stays at 0.
+*/
+class AllocationCounter {
+
+    public:
+        //Getter methods
+        static bool isCompiledIn();
+        static quint64 getCount();
+        static bool isCountingMalloc();
+};
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,58 @@
+#include "artifactfilter.h"
+
+//The scale factor that makes the median absolute deviation a consistent estimator of the standard deviation.
+static const float MAD_SCALE = 1.4826;
+
+//Smallest deviation that is ever considered an artifact. Stops a perfectly flat window (MAD of 0) from rejecting every reading.
+static const float MIN_DEVIATION = 1.0;
+
+//Constructor for the ArtifactFilter class.
+ArtifactFilter::ArtifactFilter(float threshold) {
+    this->threshold = threshold;
+    reset();
+}
+
+//Getter methods
+int ArtifactFilter::getRejectedCount() {return this->rejectedCount;}
+
+/*Purpose: Empties the window and the rejected reading count so the filter can be used for a new Session.*/
+void ArtifactFilter::reset() {
+    this->windowCount = 0;
+    this->windowStart = 0;
+    this->rejectedCount = 0;
+}
+
+/*  Purpose: Returns the cleaned value of 'reading'. Readings are passed through unchanged until the window is full. After that, a
+    reading that is an outlier with respect to the window is counted as rejected and replaced with the window median.*/
+float ArtifactFilter::filter(float reading) {
+    float cleaned = reading;
+
+    if(this->windowCount == WINDOW_SIZE) {
+        float values[WINDOW_SIZE];
+        std::copy(this->window, this->window + WINDOW_SIZE, values);
+        float windowMedian = median(values, WINDOW_SIZE);
+
+        //Compute the median absolute deviation of the window.
+        for(int i=0;i<WINDOW_SIZE;i++) values[i] = qAbs(this->window[i] - windowMedian);
+        float allowedDeviation = qMax(this->threshold * MAD_SCALE * median(values, WINDOW_SIZE), MIN_DEVIATION);
+
+        if(qAbs(reading - windowMedian) > allowedDeviation) {
+            cleaned = windowMedian;
+            this->rejectedCount++;
+        }
+
+        //Overwrite the oldest reading.
+        this->window[this->windowStart] = cleaned;
+        this->windowStart = (this->windowStart + 1) % WINDOW_SIZE;
+    } else {
+        this->window[(this->windowStart + this->windowCount) % WINDOW_SIZE] = cleaned;
+        this->windowCount++;
+    }
+    return cleaned;
+}
+
+/*Purpose: Helper method that returns the median of the 'size' values in 'values'. The order of 'values' is modified.*/
+float ArtifactFilter::median(float* values, int size) {
+    std::nth_element(values, values + size / 2, values + size);
+    return values[size / 2];
+}
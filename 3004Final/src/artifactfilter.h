@@ -0,0 +1,39 @@
+#ifndef ARTIFACTFILTER_H
+#define ARTIFACTFILTER_H
+
+#include <QtMath>
+#include <algorithm>
+
+/*  The ArtifactFilter class sits between the sensor (Datagen) and the Session. It is a streaming Hampel filter: every new reading is
+    compared against the median of the most recent WINDOW_SIZE accepted readings and, if it is further than 'threshold' scaled median
+    absolute deviations away from it, the reading is rejected and replaced by the window median. The window is a fixed size ring buffer
+    so each reading costs O(WINDOW_SIZE) = O(1) work and no allocations.
+*/
+class ArtifactFilter {
+
+    public:
+        static const int WINDOW_SIZE = 7;                       //Number of recent readings the median is computed over.
+
+        //Constructor
+        ArtifactFilter(float threshold = 3.0);
+
+        //Getter methods
+        int getRejectedCount();
+
+        //Setter methods
+        void reset();
+
+        float filter(float reading);
+
+    private:
+        float window[WINDOW_SIZE];                              //Ring buffer of the most recent (cleaned) readings.
+        int windowCount;                                        //Number of valid readings currently stored in 'window'.
+        int windowStart;                                        //Index of the oldest reading in 'window'.
+        float threshold;                                        //Number of scaled MADs a reading may deviate before being rejected.
+        int rejectedCount;                                      //Number of readings rejected since the last reset.
+
+        //Helper methods
+        float median(float* values, int size);
+};
+
+#endif // ARTIFACTFILTER_H
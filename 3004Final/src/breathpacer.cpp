@@ -0,0 +1,53 @@
+#include "breathpacer.h"
+
+//Constructor for the BreathPacer class.
+BreathPacer::BreathPacer(int maxFps, QObject* parent): QObject(parent) {
+    this->breathLength = 10000;
+    this->cycleStart = -1;
+    this->frameTimer = new QTimer(this);
+    this->frameTimer->setTimerType(Qt::PreciseTimer);
+    this->frameTimer->setInterval(1000 / qMax(maxFps, 1));
+    connect(frameTimer, &QTimer::timeout, this, &BreathPacer::emitFrame);
+}
+
+//Getter methods
+
+/*Purpose: Returns how far through the current breath the pacer is, from 0 (start of the inhale) up to but not including 1.*/
+float BreathPacer::getPhase() {
+    if(this->cycleStart < 0) return 0;
+    return (float) ((SimClock::now() - this->cycleStart) % this->breathLength) / (float) this->breathLength;
+}
+
+//The first half of every breath is the inhale and the second half is the exhale.
+bool BreathPacer::isInhaling() {return getPhase() < 0.5;}
+
+/*Purpose: Returns the position of the pacer from 0 (lungs empty) to 100 (lungs full).*/
+int BreathPacer::getValue() {
+    float phase = getPhase();
+    if(phase < 0.5) return qRound(phase * 200.0);
+    return qRound((1.0 - phase) * 200.0);
+}
+
+bool BreathPacer::isRunning() {return this->frameTimer->isActive();}
+
+//Setter methods
+void BreathPacer::setBreathLength(int seconds) {this->breathLength = qMax(seconds, 1) * 1000;}
+
+/***IMPLEMENTING THE SLOTS FOR THE BREATHPACER CLASS***/
+
+/*Purpose: Starts a new breath cycle and starts reporting the pacer position.*/
+void BreathPacer::start() {
+    this->cycleStart = SimClock::now();
+    this->frameTimer->start();
+    emitFrame();
+}
+
+/*Purpose: Stops reporting the pacer position. Called whenever the Session view is not being displayed.*/
+void BreathPacer::stop() {
+    this->frameTimer->stop();
+    this->cycleStart = -1;
+}
+
+void BreathPacer::emitFrame() {
+    emit pacerUpdated(getValue(), isInhaling());
+}
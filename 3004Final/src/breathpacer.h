@@ -0,0 +1,48 @@
+#ifndef BREATHPACER_H
+#define BREATHPACER_H
+
+#include <QObject>
+#include <QTimer>
+#include "simclock.h"
+
+/*  The BreathPacer class is responsible for timing the user's breaths during a Session. Its phase is read from the SimClock on every frame,
+    so the pacer moves smoothly and independently of the Session's once per second updates, and keeps pace with the Session when the
+    device is accelerated. While running, it reports the pacer position at a capped (real time) frame rate. When stopped, it uses no timer
+    at all.
+*/
+class BreathPacer: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static const int DEFAULT_MAX_FPS = 30;
+
+        //Constructor
+        BreathPacer(int maxFps = DEFAULT_MAX_FPS, QObject* parent=0);
+
+        //Getter methods
+        float getPhase();
+        bool isInhaling();
+        int getValue();
+        bool isRunning();
+
+        //Setter methods
+        void setBreathLength(int seconds);
+
+    signals:
+        void pacerUpdated(int value, bool inhaling);    //Emitted every frame while the pacer is running.
+
+    public slots:
+        void start();
+        void stop();
+
+    private:
+        int breathLength;                               //The length of one full breath (inhale and exhale) in milliseconds.
+        qint64 cycleStart;                              //The SimClock time the pacer started at, or -1 while stopped.
+        QTimer* frameTimer;                             //Drives the pacer's frames while it is running.
+
+    private slots:
+        void emitFrame();
+};
+
+#endif // BREATHPACER_H
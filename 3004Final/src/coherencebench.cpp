@@ -0,0 +1,117 @@
+#include "coherencebench.h"
+
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+#include <intrin.h>
+#define HRV_CYCLE_COUNTER
+#elif defined(Q_PROCESSOR_X86) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG))
+#include <x86intrin.h>
+#define HRV_CYCLE_COUNTER
+#endif
+
+/*  Purpose: Runs 'engine' on every 5 second update of every stream in 'streams' and returns its cost and every score it computed. The
+    crossing counts are built beforehand the same way Session::updatePulseData() keeps them.*/
+BenchResult CoherenceBench::measure(CoherenceEngine* engine, const QVector<QVector<float>>& streams) {
+    BenchResult result;
+    result.name = engine->getName();
+    result.updates = 0;
+    result.nanoseconds = 0;
+    result.cycles = 0;
+
+    SessionArena scratch;
+    float scores[Session::NUM_COHERENCE_WINDOWS];
+    QElapsedTimer timer;
+    foreach(const QVector<float>& stream, streams) {
+        QVector<int> crossingCounts = QVector<int>(stream.size(), 0);
+        for(int i=1;i<stream.size();i++) crossingCounts[i] = crossingCounts.at(i - 1) + (stream.at(i) == (int) stream.at(0) ? 1 : 0);
+
+        CoherenceInput input;
+        input.readings = stream.constData();
+        input.crossingCounts = crossingCounts.constData();
+        for(int length = 5;length < stream.size();length += 5) {
+            input.sessionLength = length;
+            timer.start();
+            quint64 cycles = readCycleCounter();
+            engine->computeScores(input, Session::COHERENCE_WINDOWS, Session::NUM_COHERENCE_WINDOWS, scores, scratch);
+            result.cycles += readCycleCounter() - cycles;
+            result.nanoseconds += timer.nsecsElapsed();
+            result.updates++;
+            for(int w=0;w<Session::NUM_COHERENCE_WINDOWS;w++) result.scores.append(scores[w]);
+        }
+    }
+    return result;
+}
+
+/*Purpose: Returns 'length' + 1 seconds of readings from a Datagen with profile 'coherence' and seed 'seed', cleaned like a Session does.*/
+QVector<float> CoherenceBench::generateStream(QString coherence, quint32 seed, int length) {
+    Datagen generator(coherence);
+    generator.setSeed(seed);
+    ArtifactFilter filter;
+    QVector<float> stream = QVector<float>();
+    stream.reserve(length + 1);
+    QObject::connect(&generator, &Datagen::sendSensorReading, [&stream, &filter](float reading) {stream.append(filter.filter(reading));});
+    for(int i=0;i<=length;i++) generator.getSensorReading(i);
+    return stream;
+}
+
+/*  Purpose: Runs the benchmark for "--bench-coherence [seed] [streams]" and prints the cost of an update with each engine and how well
+    the fixed point scores agree with the float reference. Returns 1 if any score differs by more than the engine's TOLERANCE.*/
+int CoherenceBench::run(QStringList arguments) {
+    int index = arguments.indexOf("--bench-coherence");
+    bool seedOk = false, streamsOk = false;
+    quint32 seed = arguments.value(index + 1, "1").toUInt(&seedOk);
+    int streamCount = arguments.value(index + 2, QString::number(DEFAULT_STREAMS)).toInt(&streamsOk);
+    if(!seedOk || !streamsOk || streamCount <= 0) {
+        qCritical("Usage: %s --bench-coherence [seed] [streams]", qPrintable(arguments.value(0)));
+        return 2;
+    }
+
+    QVector<QVector<float>> streams = QVector<QVector<float>>();
+    for(int i=0;i<2 * streamCount;i++) streams.append(generateStream(i % 2 == 0 ? "Low" : "High", seed + i, STREAM_LENGTH));
+
+    FloatCoherenceEngine floatEngine;
+    FixedPointCoherenceEngine fixedPointEngine;
+    QVector<BenchResult> results = QVector<BenchResult>();
+    results.append(measure(&floatEngine, streams));
+    results.append(measure(&fixedPointEngine, streams));
+
+    qInfo("%d streams of %d seconds, %d windows per update:", streams.size(), (int) STREAM_LENGTH, (int) Session::NUM_COHERENCE_WINDOWS);
+    foreach(const BenchResult& result, results) {
+        double nanosecondsPerUpdate = result.nanoseconds / (double) qMax(result.updates, 1);
+#ifdef HRV_CYCLE_COUNTER
+        qInfo("  %-12s %6d updates  %10.0f ns/update  %10.0f cycles/update", qPrintable(result.name), result.updates,
+              nanosecondsPerUpdate, result.cycles / (double) qMax(result.updates, 1));
+#else
+        qInfo("  %-12s %6d updates  %10.0f ns/update  (no cycle counter on this CPU)", qPrintable(result.name), result.updates,
+              nanosecondsPerUpdate);
+#endif
+    }
+
+    //Compare the fixed point scores with the float reference. Scores the reference could not compute (NaN) are skipped.
+    const QVector<float>& reference = results.at(0).scores;
+    const QVector<float>& fixedPoint = results.at(1).scores;
+    int compared = 0, equal = 0;
+    float maxDifference = 0;
+    for(int i=0;i<reference.size();i++) {
+        if(qIsNaN(reference.at(i)) || reference.at(i) < 0 || reference.at(i) > CoherenceEngine::MAX_SCORE) continue;
+        float difference = qAbs(reference.at(i) - fixedPoint.at(i));
+        compared++;
+        if(difference == 0) equal++;
+        maxDifference = qMax(maxDifference, difference);
+    }
+    bool withinTolerance = maxDifference <= FixedPointCoherenceEngine::TOLERANCE;
+    qInfo("Fixed point vs float: %d of %d scores equal (%.2f%%), largest difference %.0f, tolerance %d: %s", equal, compared,
+          compared > 0 ? 100.0 * equal / compared : 0.0, maxDifference, (int) FixedPointCoherenceEngine::TOLERANCE,
+          withinTolerance ? "PASS" : "FAIL");
+    return withinTolerance ? 0 : 1;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE COHERENCEBENCH CLASS***/
+
+//Returns the CPU's time stamp counter, or 0 if the CPU has none.
+quint64 CoherenceBench::readCycleCounter() {
+#ifdef HRV_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,45 @@
+#ifndef COHERENCEBENCH_H
+#define COHERENCEBENCH_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QtNumeric>
+#include "coherenceengine.h"
+#include "floatcoherenceengine.h"
+#include "fixedpointcoherenceengine.h"
+#include "artifactfilter.h"
+#include "sessionarena.h"
+#include "session.h"
+#include "datagen.h"
+
+/*The BenchResult struct holds what one engine did on the benchmark streams.*/
+struct BenchResult {
+    QString name;                                   //The name of the engine.
+    int updates;                                    //The number of coherence updates computed.
+    qint64 nanoseconds;                             //The total time spent in the updates.
+    quint64 cycles;                                 //The total CPU cycles spent in the updates, or 0 if they cannot be counted.
+    QVector<float> scores;                          //Every window score computed, in the same order for every engine.
+};
+
+/*  The CoherenceBench class measures the cost of a coherence update with each CoherenceEngine and checks the fixed point engine against
+    the float reference. Seeded pulse streams are generated from the "Low" and "High" Datagen profiles and cleaned by an ArtifactFilter,
+    as a Session would receive them, and then every engine computes the scores of every coherence window at every 5 second update of
+    every stream. Only the engine calls are timed. Cycles are read from the CPU's time stamp counter where there is one.
+*/
+class CoherenceBench {
+
+    public:
+        static const int DEFAULT_STREAMS = 8;           //The default number of streams generated from each Datagen profile.
+        static const int STREAM_LENGTH = 600;           //The length of each stream (in seconds), long enough to fill every window.
+
+        static BenchResult measure(CoherenceEngine* engine, const QVector<QVector<float>>& streams);
+        static QVector<float> generateStream(QString coherence, quint32 seed, int length);
+        static int run(QStringList arguments);
+
+    private:
+        static quint64 readCycleCounter();
+};
+
+#endif // COHERENCEBENCH_H
@@ -0,0 +1,159 @@
+#include "coherencecomparison.h"
+
+/*  Purpose: Replays every stream through a new Session scoring with the engine called 'engineName' and returns what it scored and the
+    cost of each tick that computed a coherence update. Only those ticks are timed, and the allocations counted are the ones made during
+    them, by the engine and by the rest of the Session's tick.*/
+EngineRun CoherenceComparison::replay(QString engineName, const QVector<ComparisonStream>& streams) {
+    EngineRun run;
+    run.name = engineName;
+    run.allocations = 0;
+
+    int updates = 0;
+    foreach(const ComparisonStream& stream, streams) updates += qMax(stream.readings.size() - 1, 0) / 5;
+    run.latencies.reserve(updates);
+    run.scores.reserve(updates);
+    run.levels.reserve(updates);
+
+    QElapsedTimer timer;
+    foreach(const ComparisonStream& stream, streams) {
+        Session session(stream.challengeLevel);
+        session.setCoherenceEngine(CoherenceEngine::create(engineName));
+        Log latest = Log();
+        Log summary = Log();
+        QObject::connect(&session, &Session::getSensorReading, [&session, &stream](float seconds) {
+            session.updatePulseData(stream.readings.at((int) seconds));
+        });
+        QObject::connect(&session, &Session::updateSessionDisplay, [&latest](Log currentLog) {latest = currentLog;});
+        QObject::connect(&session, &Session::sendSessionSummary, [&summary](Log summaryLog) {summary = summaryLog;});
+
+        //Tick the Session once per reading, as the device's timer would.
+        for(int second = 0;second < stream.readings.size();second++) {
+            quint64 allocations = AllocationCounter::getCount();
+            timer.start();
+            session.updateSessionData();
+            qint64 elapsed = timer.nsecsElapsed();
+            if(second == 0 || second % 5 != 0) continue;
+            run.allocations += AllocationCounter::getCount() - allocations;
+            run.latencies.append(elapsed);
+            run.scores.append(latest.getCoherenceScore());
+            run.levels.append(latest.getCoherenceLevel());
+        }
+        session.endSession();
+        run.coherenceTimes.append(summary.getCoherenceTimes());
+        run.achievementScores.append(summary.getAchievementScore());
+    }
+    return run;
+}
+
+/*  Purpose: Returns 'streamCount' raw sensor streams from each of the "Low" and "High" Datagen profiles, seeded from 'seed' and spread
+    over the 4 challenge levels.*/
+QVector<ComparisonStream> CoherenceComparison::generateStreams(quint32 seed, int streamCount) {
+    QVector<ComparisonStream> streams = QVector<ComparisonStream>();
+    for(int i=0;i<2 * streamCount;i++) {
+        ComparisonStream stream;
+        stream.challengeLevel = (i / 2) % 4 + 1;
+        stream.readings.reserve(STREAM_LENGTH + 1);
+
+        Datagen generator(i % 2 == 0 ? "Low" : "High");
+        generator.setSeed(seed + i);
+        QObject::connect(&generator, &Datagen::sendSensorReading, [&stream](float reading) {stream.readings.append(reading);});
+        for(int second=0;second<=STREAM_LENGTH;second++) generator.getSensorReading(second);
+        streams.append(stream);
+    }
+    return streams;
+}
+
+/*  Purpose: Returns the pulse data of every stored Session of every Profile, at the challenge level it was recorded at. The stored
+    readings were already cleaned by the artifact filter, which passes them through unchanged when they are replayed.*/
+QVector<ComparisonStream> CoherenceComparison::loadRecordedStreams() {
+    QVector<ComparisonStream> streams = QVector<ComparisonStream>();
+    ProfileManager profileManager(100);
+    for(int profileNumber = 0;profileNumber < profileManager.getProfileNames().size();profileNumber++) {
+        HistoryStore store(profileManager.getProfileDirectory(profileNumber));
+        for(int i=0;i<store.count();i++) {
+            Log session = store.getSessionAt(i);
+            ComparisonStream stream;
+            stream.readings = session.getPulseData();
+            stream.challengeLevel = session.getChallengeLevel();
+            if(stream.readings.size() > 5) streams.append(stream);
+        }
+    }
+    return streams;
+}
+
+/*  Purpose: Runs the harness for "--compare-coherence [engine] [seed] [streams] [--recorded]", comparing the engine called 'engine'
+    (default "fixed") with the float reference. Returns 1 if the engines disagree on any level or on the time spent in any level.*/
+int CoherenceComparison::run(QStringList arguments) {
+    QStringList options = arguments.mid(arguments.indexOf("--compare-coherence") + 1);
+    bool recorded = options.removeAll("--recorded") > 0;
+    QString engineName = options.value(0, "fixed");
+    bool seedOk = false, streamsOk = false;
+    quint32 seed = options.value(1, "1").toUInt(&seedOk);
+    int streamCount = options.value(2, QString::number(DEFAULT_STREAMS)).toInt(&streamsOk);
+    if(!CoherenceEngine::getEngineNames().contains(engineName) || !seedOk || !streamsOk || streamCount <= 0) {
+        qCritical("Usage: %s --compare-coherence [%s] [seed] [streams] [--recorded]", qPrintable(arguments.value(0)),
+                  qPrintable(CoherenceEngine::getEngineNames().join('|')));
+        return 2;
+    }
+
+    QVector<ComparisonStream> streams = recorded ? loadRecordedStreams() : generateStreams(seed, streamCount);
+    if(streams.isEmpty()) {
+        qCritical("There are no recorded Sessions to replay");
+        return 2;
+    }
+
+    EngineRun reference = replay("float", streams);
+    EngineRun candidate = replay(engineName, streams);
+    qInfo("%d %s streams, %d coherence updates each:", streams.size(), recorded ? "recorded" : "generated", reference.latencies.size());
+    printCost(reference);
+    printCost(candidate);
+
+    //Scores are equal if both are the same number or both could not be computed (NaN).
+    int equalScores = 0, equalLevels = 0, equalTimes = 0;
+    float maxScoreDifference = 0, maxAchievementDifference = 0;
+    for(int i=0;i<reference.scores.size();i++) {
+        float a = reference.scores.at(i), b = candidate.scores.at(i);
+        if(a == b || (qIsNaN(a) && qIsNaN(b))) equalScores++;
+        else maxScoreDifference = qMax(maxScoreDifference, qIsNaN(a) || qIsNaN(b) ? std::numeric_limits<float>::infinity() : qAbs(a - b));
+        if(reference.levels.at(i) == candidate.levels.at(i)) equalLevels++;
+    }
+    for(int i=0;i<streams.size();i++) {
+        if(reference.coherenceTimes.at(i) == candidate.coherenceTimes.at(i)) equalTimes++;
+        maxAchievementDifference = qMax(maxAchievementDifference, qAbs(reference.achievementScores.at(i) - candidate.achievementScores.at(i)));
+    }
+
+    int updates = reference.scores.size();
+    bool agrees = equalLevels == updates && equalTimes == streams.size();
+    qInfo("Agreement of %s with float:", qPrintable(engineName));
+    qInfo("  scores          %6d of %6d equal, largest difference %g", equalScores, updates, maxScoreDifference);
+    qInfo("  levels          %6d of %6d equal", equalLevels, updates);
+    qInfo("  coherenceTimes  %6d of %6d sessions equal", equalTimes, streams.size());
+    qInfo("  achievement     largest difference %g", maxAchievementDifference);
+    qInfo("Behaviour %s", agrees ? "preserved: PASS" : "changed: FAIL");
+    return agrees ? 0 : 1;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE COHERENCECOMPARISON CLASS***/
+
+/*Purpose: Prints the latency percentiles, throughput and allocations of the coherence updates of 'run'.*/
+void CoherenceComparison::printCost(const EngineRun& run) {
+    qint64 total = 0;
+    foreach(qint64 latency, run.latencies) total += latency;
+    int updates = qMax(run.latencies.size(), 1);
+    QString allocations = "allocations not counted (build with CONFIG+=alloc_count)";
+    if(AllocationCounter::isCompiledIn()) {
+        allocations = QString("%1 allocations/update%2").arg(run.allocations / (double) updates, 0, 'f', 2)
+                .arg(AllocationCounter::isCountingMalloc() ? "" : " (operator new only)");
+    }
+    qInfo("  %-6s mean %8.0f ns  p50 %8lld ns  p99 %8lld ns  max %8lld ns  %10.0f updates/s  %s",
+          qPrintable(run.name), total / (double) updates, percentile(run.latencies, 0.5), percentile(run.latencies, 0.99),
+          percentile(run.latencies, 1), total > 0 ? 1e9 * run.latencies.size() / total : 0.0, qPrintable(allocations));
+}
+
+//Returns the latency that 'fraction' of 'latencies' are at or below.
+qint64 CoherenceComparison::percentile(QVector<qint64> latencies, double fraction) {
+    if(latencies.isEmpty()) return 0;
+    int rank = qBound(0, (int) qCeil(fraction * latencies.size()) - 1, latencies.size() - 1);
+    std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+    return latencies.at(rank);
+}
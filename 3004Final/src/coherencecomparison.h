@@ -0,0 +1,59 @@
+#ifndef COHERENCECOMPARISON_H
+#define COHERENCECOMPARISON_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QElapsedTimer>
+#include <QtNumeric>
+#include <algorithm>
+#include "coherenceengine.h"
+#include "allocationcounter.h"
+#include "profilemanager.h"
+#include "historystore.h"
+#include "session.h"
+#include "datagen.h"
+
+/*The ComparisonStream struct is one stream of sensor readings replayed through a Session, and the challenge level it is replayed at.*/
+struct ComparisonStream {
+    QVector<float> readings;                        //readings[i] is the sensor reading at second i.
+    int challengeLevel;
+};
+
+/*The EngineRun struct holds what Sessions scoring with one engine computed on every stream, and what their coherence updates cost.*/
+struct EngineRun {
+    QString name;                                   //The name of the engine.
+    QVector<qint64> latencies;                      //The time (in ns) of every Session tick that computed a coherence update.
+    quint64 allocations;                            //The heap allocations made during those ticks.
+    QVector<float> scores;                          //The coherence score of every update, stream after stream.
+    QVector<QString> levels;                        //The coherence level of every update, stream after stream.
+    QVector<QMap<QString, int>> coherenceTimes;     //The summary's time in each level, for every stream.
+    QVector<float> achievementScores;               //The summary's achievement score, for every stream.
+};
+
+/*  The CoherenceComparison class is an A/B harness for the coherence algorithm. It replays the same streams through a Session scoring
+    with the reference FloatCoherenceEngine and through one scoring with another engine, exactly as the device would run them (artifact
+    filter, 5 second updates, levels and summary). It reports the latency, throughput and heap allocations of the coherence updates of
+    each, and whether the candidate agrees with the reference on every score, level, 'coherenceTimes' and achievement score.
+
+    The streams are either generated from seeded "Low" and "High" Datagen profiles at every challenge level, or the recorded pulse data
+    of every stored Session of every Profile.
+*/
+class CoherenceComparison {
+
+    public:
+        static const int DEFAULT_STREAMS = 8;           //The default number of streams generated from each Datagen profile.
+        static const int STREAM_LENGTH = 600;           //The length of each generated stream (in seconds).
+
+        static EngineRun replay(QString engineName, const QVector<ComparisonStream>& streams);
+        static QVector<ComparisonStream> generateStreams(quint32 seed, int streamCount);
+        static QVector<ComparisonStream> loadRecordedStreams();
+        static int run(QStringList arguments);
+
+    private:
+        static void printCost(const EngineRun& run);
+        static qint64 percentile(QVector<qint64> latencies, double fraction);
+};
+
+#endif // COHERENCECOMPARISON_H
@@ -0,0 +1,24 @@
+#include "coherenceengine.h"
+#include "floatcoherenceengine.h"
+#include "fixedpointcoherenceengine.h"
+
+/*  Purpose: Returns a new instance of the engine the device was built with. Building with "qmake CONFIG+=fixed_point" selects the
+    FixedPointCoherenceEngine, otherwise the FloatCoherenceEngine is used. The caller owns the engine.*/
+CoherenceEngine* CoherenceEngine::create() {
+#ifdef HRV_FIXED_POINT
+    return new FixedPointCoherenceEngine();
+#else
+    return new FloatCoherenceEngine();
+#endif
+}
+
+/*  Purpose: Returns a new instance of the engine called 'name' ("float" or "fixed"), or NULL if there is none. New engines are added here
+    so that the comparison harness can run them. The caller owns the engine.*/
+CoherenceEngine* CoherenceEngine::create(QString name) {
+    if(name == "float") return new FloatCoherenceEngine();
+    if(name == "fixed") return new FixedPointCoherenceEngine();
+    return NULL;
+}
+
+//Returns the names accepted by create(name).
+QStringList CoherenceEngine::getEngineNames() {return QStringList() << "float" << "fixed";}
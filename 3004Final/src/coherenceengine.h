@@ -0,0 +1,41 @@
+#ifndef COHERENCEENGINE_H
+#define COHERENCEENGINE_H
+
+#include <QString>
+#include <QStringList>
+#include "sessionarena.h"
+
+/*The CoherenceInput struct is the shared pulse data of a Session that every coherence window is scored from.*/
+struct CoherenceInput {
+    const float* readings;                          //readings[0] is the baseline and readings[i] was observed at second i.
+    const int* crossingCounts;                      //crossingCounts[i] is the number of readings 1 to i equal to the (integer) baseline.
+    int sessionLength;                              //The index of the newest reading.
+};
+
+/*  The CoherenceEngine class is the interface of the coherence scoring algorithm. An engine scores every window of a Session from one
+    CoherenceInput, using 'scratch' for any working data that only lives for the call. The FloatCoherenceEngine is the reference
+    implementation and the FixedPointCoherenceEngine computes the same scores with integer arithmetic only, for low-power hardware.
+    Sessions use the engine returned by create(), which is selected when the device is built. create(name) returns any engine by the name
+    used on the command line, so harnesses can run a Session with an engine other than the build's.
+*/
+class CoherenceEngine {
+
+    public:
+        static const int MAX_SCORE = 16;            //Coherence scores are between 0 and MAX_SCORE.
+
+        virtual ~CoherenceEngine() {}
+
+        //Getter methods
+        virtual QString getName() = 0;
+
+        /*  Purpose: Writes the coherence score of the window of the last 'windowLengths[w]' seconds of 'input' to 'scores[w]', for each
+            of the 'windowCount' windows.*/
+        virtual void computeScores(const CoherenceInput& input, const int* windowLengths, int windowCount, float* scores,
+                                   SessionArena& scratch) = 0;
+
+        static CoherenceEngine* create();
+        static CoherenceEngine* create(QString name);
+        static QStringList getEngineNames();
+};
+
+#endif // COHERENCEENGINE_H
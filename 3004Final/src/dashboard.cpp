@@ -0,0 +1,119 @@
+#include "dashboard.h"
+
+//Constructor for the Dashboard class. Participants alternate between the "Low" and "High" sensor profiles and the 4 challenge levels.
+Dashboard::Dashboard(int participants, QWidget* parent): QWidget(parent) {
+    participants = qBound(1, participants, (int) MAX_PARTICIPANTS);
+
+    //The pipelines' Sessions are created here on the GUI thread, which also fills CHALLENGE_THRESHOLDS before any worker reads it.
+    for(int i=0;i<participants;i++) {
+        this->pipelines.append(new DashboardPipeline(i + 1, i % 2 == 0 ? "Low" : "High", (i / 2) % 4 + 1, this));
+    }
+    this->droppedTicks = 0;
+    this->columns = qCeil(qSqrt(participants * TILE_HEIGHT / (qreal) TILE_WIDTH));
+    this->columns = qBound(1, this->columns, participants);
+    int rows = (participants + this->columns - 1) / this->columns;
+    setFixedSize(this->columns * TILE_WIDTH, rows * TILE_HEIGHT + STATUS_HEIGHT);
+    setWindowTitle(QString("HRV Dashboard - %1 participants").arg(participants));
+
+    this->scheduler = new RenderScheduler(RenderScheduler::DEFAULT_MAX_FPS, this);
+    connect(this->scheduler, &RenderScheduler::renderFrame, this, &Dashboard::renderFrame);
+
+    this->clock = new QTimer(this);
+    connect(this->clock, &QTimer::timeout, this, &Dashboard::tick);
+    this->clock->setTimerType(Qt::PreciseTimer);
+    this->clock->start(SimClock::toWallInterval(Session::getTickInterval()));
+    connect(SimClock::instance(), &SimClock::speedChanged, this, [this]() {
+        this->clock->setInterval(SimClock::toWallInterval(Session::getTickInterval()));
+    });
+    this->statusTimer.start();
+}
+
+//Destructor for the Dashboard class. Waits for the ticks in progress, which use the pipelines.
+Dashboard::~Dashboard() {
+    this->clock->stop();
+    this->pool.waitForDone();
+}
+
+/***IMPLEMENTING THE SLOTS FOR THE DASHBOARD CLASS***/
+
+/*Purpose: Starts a tick of every pipeline that finished its previous one, and updates the status line once per second.*/
+void Dashboard::tick() {
+    HRV_TRACE_SCOPE("Dashboard tick");
+    foreach(DashboardPipeline* pipeline, this->pipelines) {
+        if(!pipeline->tryBeginTick()) {
+            this->droppedTicks++;
+            continue;
+        }
+        QtConcurrent::run(&this->pool, [this, pipeline]() {
+            pipeline->tick();
+            this->completedTicks.ref();
+
+            //Only the first finished tick of a frame posts to the GUI thread.
+            if(this->framePending.testAndSetOrdered(0, 1)) QMetaObject::invokeMethod(this->scheduler, "requestFrame", Qt::QueuedConnection);
+        });
+    }
+
+    if(this->statusTimer.elapsed() >= 1000) {
+        int ticks = this->completedTicks.fetchAndStoreRelaxed(0);
+        this->status = QString("%1 participants on %2 threads, %3 ticks/s, %4 dropped").arg(this->pipelines.size())
+                .arg(this->pool.maxThreadCount()).arg(ticks * 1000.0 / this->statusTimer.restart(), 0, 'f', 0).arg(this->droppedTicks);
+        update(getStatusRect());
+    }
+}
+
+/*Purpose: Repaints the tiles that changed since the last frame. Qt merges the tiles into a single paint event.*/
+void Dashboard::renderFrame() {
+    this->framePending.storeRelease(0);                 //Ticks finishing from now on request the next frame.
+    for(int i=0;i<this->pipelines.size();i++) {
+        if(this->pipelines.at(i)->takeDirty()) update(getTileRect(i));
+    }
+}
+
+/*Purpose: Paints every tile in the region being repainted, and the status line.*/
+void Dashboard::paintEvent(QPaintEvent* event) {
+    HRV_TRACE_SCOPE("Dashboard paint");
+    QPainter painter(this);
+    painter.fillRect(event->rect(), Qt::white);
+    for(int i=0;i<this->pipelines.size();i++) {
+        QRect rect = getTileRect(i);
+        if(!event->region().intersects(rect)) continue;
+        paintTile(&painter, rect, this->pipelines.at(i)->getParticipant(), this->pipelines.at(i)->getTileState());
+    }
+    if(event->region().intersects(getStatusRect())) painter.drawText(getStatusRect().adjusted(4, 0, -4, 0), Qt::AlignVCenter, this->status);
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE DASHBOARD CLASS***/
+
+QRect Dashboard::getTileRect(int index) {
+    return QRect((index % this->columns) * TILE_WIDTH, (index / this->columns) * TILE_HEIGHT, TILE_WIDTH, TILE_HEIGHT);
+}
+
+QRect Dashboard::getStatusRect() {
+    return QRect(0, height() - STATUS_HEIGHT, width(), STATUS_HEIGHT);
+}
+
+/*  Purpose: Paints the tile of 'participant' in 'rect': a frame in the colour of the coherence level (red for "Low", blue for "Medium",
+    green for "High"), the Session time and scores, and the graph of the last readings.*/
+void Dashboard::paintTile(QPainter* painter, const QRect& rect, int participant, const TileState& state) {
+    QColor levelColor = Qt::lightGray;
+    if(state.coherenceLevel == "Low") levelColor = Qt::red;
+    else if(state.coherenceLevel == "Medium") levelColor = Qt::blue;
+    else if(state.coherenceLevel == "High") levelColor = Qt::darkGreen;
+
+    QRect frame = rect.adjusted(2, 2, -3, -3);
+    painter->setPen(QPen(levelColor, 2));
+    painter->drawRect(frame);
+
+    painter->setPen(Qt::black);
+    QRect text = frame.adjusted(4, 2, -4, 0);
+    text.setHeight(14);
+    int seconds = qMax(state.sessionLength, 0);
+    painter->drawText(text, Qt::AlignLeft | Qt::AlignVCenter, QString("P%1").arg(participant, 2, 10, QChar('0')));
+    painter->drawText(text, Qt::AlignRight | Qt::AlignVCenter, QString("%1:%2").arg(seconds / 60, 2, 10, QChar('0'))
+                      .arg(seconds % 60, 2, 10, QChar('0')));
+    text.translate(0, 14);
+    painter->drawText(text, Qt::AlignLeft | Qt::AlignVCenter, QString("Coh %1  Ach %2  HR %3").arg(state.coherenceScore, 0, 'f', 1)
+                      .arg(state.achievementScore, 0, 'f', 0).arg(state.heartRate, 0, 'f', 0));
+
+    HrvPlot::paint(painter, QRectF(frame.adjusted(4, 34, -4, -4)), state.recentPulse);
+}
@@ -0,0 +1,66 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <QWidget>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QTimer>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QtConcurrent>
+#include <QtMath>
+#include "dashboardpipeline.h"
+#include "renderscheduler.h"
+#include "hrvplot.h"
+#include "tracer.h"
+
+/*  The Dashboard class is the station view for group classes: it monitors many participants at once, each with its own sensor and
+    Session (a DashboardPipeline), and shows every participant as a compact tile.
+
+    One clock on the GUI thread starts a tick of every pipeline on a shared QThreadPool each simulated Session second, so the Sessions run
+    on all cores and the GUI thread only paints. Raising the SimClock's speed raises the load on the pool. A pipeline still busy with its
+    previous tick skips the second and the skip is counted. Workers report finished ticks through one queued frame request at a time, and
+    the RenderScheduler coalesces them into at most RenderScheduler::DEFAULT_MAX_FPS frames per second, each repainting only the tiles
+    that changed.
+*/
+class Dashboard: public QWidget {
+
+    Q_OBJECT
+
+    public:
+        static const int DEFAULT_PARTICIPANTS = 16;
+        static const int MAX_PARTICIPANTS = 64;
+        static const int TILE_WIDTH = 150;              //The size (in pixels) of a participant's tile.
+        static const int TILE_HEIGHT = 86;
+        static const int STATUS_HEIGHT = 20;            //The height of the status line below the tiles.
+
+        //Constructor and destructor
+        Dashboard(int participants, QWidget* parent = nullptr);
+        ~Dashboard();
+
+    protected:
+        void paintEvent(QPaintEvent* event) override;
+
+    private slots:
+        void tick();
+        void renderFrame();
+
+    private:
+        QVector<DashboardPipeline*> pipelines;
+        QThreadPool pool;                               //Ticks the pipelines, one thread per core.
+        QTimer* clock;                                  //Starts a tick of every pipeline once per Session second.
+        RenderScheduler* scheduler;                     //Coalesces the frame requests of the workers.
+        QAtomicInt framePending;                        //1 while a frame request is queued for the GUI thread.
+        QAtomicInt completedTicks;                      //Ticks finished by the workers since the status line was last updated.
+        int columns;                                    //The number of tiles in a row.
+        int droppedTicks;                               //Ticks skipped because the pipeline was still busy.
+        QElapsedTimer statusTimer;                      //Time since the status line was last updated.
+        QString status;
+
+        //Helper methods
+        QRect getTileRect(int index);
+        QRect getStatusRect();
+        void paintTile(QPainter* painter, const QRect& rect, int participant, const TileState& state);
+};
+
+#endif // DASHBOARD_H
@@ -0,0 +1,61 @@
+#include "dashboardpipeline.h"
+
+/*  Constructor for the DashboardPipeline class. The Session and Datagen are connected directly, so a tick runs entirely on the thread
+    that calls tick(), whichever thread the objects belong to.*/
+DashboardPipeline::DashboardPipeline(int participant, QString coherence, int challengeLevel, QObject* parent): QObject(parent) {
+    this->participant = participant;
+    this->session = new Session(challengeLevel, 10, this);
+    this->generator = new Datagen(coherence, this);
+    this->generator->setSeed(participant);
+    this->state.sessionLength = 0;
+    this->state.coherenceScore = 0;
+    this->state.coherenceLevel = "NA";
+    this->state.achievementScore = 0;
+    this->state.heartRate = 0;
+
+    connect(this->session, &Session::getSensorReading, this->generator, &Datagen::getSensorReading, Qt::DirectConnection);
+    connect(this->generator, &Datagen::sendSensorReading, this->session, &Session::updatePulseData, Qt::DirectConnection);
+    connect(this->session, &Session::updateSessionDisplay, this, &DashboardPipeline::updateTileState, Qt::DirectConnection);
+}
+
+//Getter methods
+int DashboardPipeline::getParticipant() {return this->participant;}
+
+/*Purpose: Returns a copy of what the tile shows. Called on the GUI thread.*/
+TileState DashboardPipeline::getTileState() {
+    QMutexLocker locker(&this->stateMutex);
+    return this->state;
+}
+
+/*Purpose: Returns whether the tile changed since the last call, and marks it as unchanged.*/
+bool DashboardPipeline::takeDirty() {return this->dirty.fetchAndStoreAcquire(0) != 0;}
+
+//Setter methods
+
+/*  Purpose: Claims the pipeline for one tick. Returns false if a worker is still ticking it, in which case the tick is dropped rather than
+    queued so that an overloaded dashboard falls behind by skipping seconds instead of building a backlog.*/
+bool DashboardPipeline::tryBeginTick() {return this->busy.testAndSetAcquire(0, 1);}
+
+/*Purpose: Advances the participant's Session by one second. Runs on a worker of the dashboard's pool after tryBeginTick() succeeded.*/
+void DashboardPipeline::tick() {
+    this->session->updateSessionData();
+    this->busy.storeRelease(0);
+}
+
+/***IMPLEMENTING THE SLOTS FOR THE DASHBOARDPIPELINE CLASS***/
+
+/*Purpose: Copies what the tile shows out of the newest Session tick. Runs on the worker ticking the pipeline.*/
+void DashboardPipeline::updateTileState(Log currentLog) {
+    const QVector<float> pulseData = currentLog.getPulseData();
+    QVector<float> recentPulse = pulseData.mid(qMax(pulseData.size() - RECENT_SECONDS, 0));
+
+    QMutexLocker locker(&this->stateMutex);
+    this->state.sessionLength = currentLog.getSessionLength();
+    this->state.coherenceScore = currentLog.getCoherenceScore();
+    this->state.coherenceLevel = currentLog.getCoherenceLevel();
+    this->state.achievementScore = currentLog.getAchievementScore();
+    this->state.heartRate = pulseData.isEmpty() ? 0 : pulseData.last();
+    this->state.recentPulse.swap(recentPulse);
+    locker.unlock();
+    this->dirty.storeRelease(1);
+}
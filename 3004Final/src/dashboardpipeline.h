@@ -0,0 +1,61 @@
+#ifndef DASHBOARDPIPELINE_H
+#define DASHBOARDPIPELINE_H
+
+#include <QObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QVector>
+#include <QString>
+#include "session.h"
+#include "datagen.h"
+#include "log.h"
+
+/*The TileState struct is what a participant's tile on the dashboard shows, copied out of the participant's latest Session tick.*/
+struct TileState {
+    int sessionLength;
+    float coherenceScore;
+    QString coherenceLevel;                         //"NA" until the first coherence score is computed.
+    float achievementScore;
+    float heartRate;                                //The newest cleaned reading.
+    QVector<float> recentPulse;                     //The last RECENT_SECONDS readings, for the tile's graph.
+};
+
+/*  The DashboardPipeline class is one participant of the dashboard: a Session fed by its own Datagen, as in the device, but ticked by the
+    dashboard's thread pool instead of the Session's own timer. Every object of a pipeline is only ever used by the one task ticking it,
+    since a pipeline is never ticked twice at once, so the pipelines need no locking except around the TileState that the GUI thread
+    reads.
+*/
+class DashboardPipeline: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static const int RECENT_SECONDS = 64;           //The readings shown in a tile's graph, the length of the primary coherence window.
+
+        //Constructor
+        DashboardPipeline(int participant, QString coherence, int challengeLevel, QObject* parent = nullptr);
+
+        //Getter methods
+        int getParticipant();
+        TileState getTileState();
+        bool takeDirty();
+
+        //Setter methods
+        bool tryBeginTick();
+        void tick();
+
+    private:
+        int participant;                                //The participant's number, starting at 1.
+        Session* session;
+        Datagen* generator;
+        QMutex stateMutex;                              //Guards 'state' between the worker ticking the pipeline and the GUI thread.
+        TileState state;
+        QAtomicInt busy;                                //1 while a worker is ticking the pipeline.
+        QAtomicInt dirty;                               //1 if 'state' changed since the GUI thread last read it.
+
+    private slots:
+        void updateTileState(Log currentLog);
+};
+
+#endif // DASHBOARDPIPELINE_H
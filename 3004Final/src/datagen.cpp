@@ -20,6 +20,7 @@ Datagen::~Datagen() {
 /* Purpose: This function is responsible for returning a value from the sine wave with the given frequency and vertical shift after the
     given number of seconds has elapsed.*/
 void Datagen::getSensorReading(float seconds) {
+    HRV_TRACE_SCOPE("Sensor read");
 
     float reading = applyRandomNoise(this->amplitude * qSin(2.0 * (float) M_PI * this->period * (seconds / 60.0))) + this->vShift;
     //Sends the Sensor reading to the current Session object.
@@ -32,6 +33,11 @@ void Datagen::setPeriod(float period) {
 }
 
 
+/*Purpose: Reseeds the noise generator so that the same readings are produced every time for the same seed.*/
+void Datagen::setSeed(quint32 seed) {
+    this->generator->seed(seed);
+}
+
 /*Purpose: this method is a helper method used to apply random noise to the pulse readings. (NO NOISE HAS BEEN ADDED YET)*/
 float Datagen::applyRandomNoise(float reading) {
     return (float) reading * (float) generator->generateDouble();
@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QRandomGenerator>
 #include <QDateTime>
+#include "tracer.h"
 
 /*The Datagen class is responsible for generating the pulse data that is used to compute the coherence metrics. */
 class Datagen: public QObject
@@ -21,6 +22,7 @@ class Datagen: public QObject
     public slots:
         void getSensorReading(float seconds);
         void setPeriod(float period);
+        void setSeed(quint32 seed);
 
     private:
          float amplitude;                        //The amplitude of the Sine wave.
@@ -0,0 +1,56 @@
+#include "devicesnapshot.h"
+
+//Written at the start of the snapshot file so that a file from a different version is not misread.
+static const quint32 SNAPSHOT_MAGIC = 0x534e5032;       //"SNP2"
+
+//Constructor for the DeviceSnapshot class. The default snapshot is the Main Menu with the default Settings.
+DeviceSnapshot::DeviceSnapshot() {
+    this->menuPath = QStringList();
+    this->selectedRow = 0;
+    this->view = MenuView;
+    this->challengeLevel = 3;
+    this->pacerSpeed = 10;
+    this->profileIndex = 0;
+    this->summaryHistoryRow = -1;
+}
+
+/*Purpose: Writes the snapshot to the file at 'path'. Returns false if the file could not be written.*/
+bool DeviceSnapshot::save(QString path) {
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+    QDataStream out(&file);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << SNAPSHOT_MAGIC << this->menuPath << (qint32) this->selectedRow << (qint32) this->view << (qint32) this->challengeLevel
+        << (qint32) this->pacerSpeed << (qint32) this->profileIndex;
+    if(this->view == SummaryView) out << this->summary << (qint32) this->summaryHistoryRow;
+    return out.status() == QDataStream::Ok;
+}
+
+/*Purpose: Reads the snapshot from the file at 'path'. Returns false (leaving the snapshot unchanged) if there is no valid snapshot.*/
+bool DeviceSnapshot::load(QString path) {
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic;
+    QStringList menuPath;
+    qint32 selectedRow, view, challengeLevel, pacerSpeed, profileIndex, summaryHistoryRow = -1;
+    Log summary;
+    in >> magic;
+    if(magic != SNAPSHOT_MAGIC) return false;
+    in >> menuPath >> selectedRow >> view >> challengeLevel >> pacerSpeed >> profileIndex;
+    if(view == SummaryView) in >> summary >> summaryHistoryRow;
+    if(in.status() != QDataStream::Ok || view < MenuView || view > SummaryView) return false;
+
+    this->menuPath = menuPath;
+    this->selectedRow = selectedRow;
+    this->view = (View) view;
+    this->challengeLevel = challengeLevel;
+    this->pacerSpeed = pacerSpeed;
+    this->profileIndex = profileIndex;
+    this->summary = summary;
+    this->summaryHistoryRow = summaryHistoryRow;
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef DEVICESNAPSHOT_H
+#define DEVICESNAPSHOT_H
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QDataStream>
+#include "log.h"
+
+/*  The DeviceSnapshot class holds the state of the device that is saved when it is turned off and restored when it is turned back on:
+    the Menu being displayed, the current view, the Settings and the active Profile. It is written to a small binary file so that it can
+    be restored almost instantly. The battery level is not part of it: the PowerModel keeps it while the device is off (it can be
+    recharged then), so restoring the view must never change it.
+*/
+class DeviceSnapshot {
+
+    public:
+        //The views that can be restored. An active Session cannot be resumed, so it is restored as the Menu it was started from.
+        enum View {MenuView, SliderView, SummaryView};
+
+        //Constructor
+        DeviceSnapshot();
+
+        QStringList menuPath;                           //The names of the Menus from the Main Menu (excluded) to the current Menu.
+        int selectedRow;                                //The selected row of the current Menu.
+        View view;                                      //The view being displayed.
+        int challengeLevel;                             //The challenge level Setting.
+        int pacerSpeed;                                 //The breath pacer speed Setting.
+        int profileIndex;                               //The position of the active Profile.
+        Log summary;                                    //The displayed summary if 'view' is SummaryView.
+        int summaryHistoryRow;                          //The position in the Session history of the summary, or -1.
+
+        bool save(QString path);
+        bool load(QString path);
+};
+
+#endif // DEVICESNAPSHOT_H
@@ -0,0 +1,143 @@
+#include "fixedpointcoherenceengine.h"
+
+const qint32 FixedPointCoherenceEngine::ONE;
+
+/*  The lookup tables of the engine. On the device they would be constant tables in flash, here they are filled once, the first time an
+    engine needs them (function local statics are initialized safely even if Sessions on several threads start at once).*/
+struct FixedPointTables {
+    qint32 sine[(1 << FixedPointCoherenceEngine::SINE_TABLE_BITS) + 1];         //sin(2*pi*k/size) in Q16.16, one extra for interpolation.
+    qint32 exp2[(1 << FixedPointCoherenceEngine::EXP2_TABLE_BITS) + 1];         //2^(k/size) in Q16.16, one extra for interpolation.
+
+    FixedPointTables() {
+        const int sineSize = 1 << FixedPointCoherenceEngine::SINE_TABLE_BITS;
+        const int exp2Size = 1 << FixedPointCoherenceEngine::EXP2_TABLE_BITS;
+        for(int k=0;k<=sineSize;k++) sine[k] = qRound(qSin(2.0 * M_PI * k / sineSize) * FixedPointCoherenceEngine::ONE);
+        for(int k=0;k<=exp2Size;k++) exp2[k] = qRound(qPow(2.0, (double) k / exp2Size) * FixedPointCoherenceEngine::ONE);
+    }
+};
+
+static const FixedPointTables& tables() {
+    static const FixedPointTables instance;
+    return instance;
+}
+
+//Getter methods
+QString FixedPointCoherenceEngine::getName() {return "fixed point";}
+
+/*  Purpose: Scores every window of 'input' exactly like FloatCoherenceEngine::computeScores(), with every step done in Q16.16 fixed
+    point. The sum of the squared errors is divided by the window size once instead of once per reading.*/
+void FixedPointCoherenceEngine::computeScores(const CoherenceInput& input, const int* windowLengths, int windowCount, float* scores,
+                                              SessionArena& scratch) {
+    int sessionLength = input.sessionLength;
+    qint32 baseline = ((qint32) input.readings[0]) << FRACTION_BITS;
+
+    SessionArena::Mark mark = scratch.getMark();
+    Window* windows = scratch.allocate<Window>(windowCount);
+    int firstReading = sessionLength;
+    for(int w=0;w<windowCount;w++) {
+        Window& window = windows[w];
+        int length = windowLengths[w];
+
+        if(sessionLength < length) window.start = 1;
+        else window.start = sessionLength - length + 1;
+        window.size = sessionLength - window.start + 1;
+        firstReading = qMin(firstReading, window.start);
+
+        //period = (crosses / 2) / (seconds / 60) = crosses * 30 / seconds.
+        qint64 numCrosses = input.crossingCounts[sessionLength] - input.crossingCounts[window.start - 1];
+        window.period = (qint32) (((numCrosses * 30) << FRACTION_BITS) / qMin(sessionLength, length));
+
+        window.minError = std::numeric_limits<qint64>::max();
+        window.maxError = 0;
+        window.errorSum = 0;
+    }
+
+    for(int i=firstReading;i<=sessionLength;i++) {
+        qint32 reading = qRound(input.readings[i] * ONE);
+        for(int w=0;w<windowCount;w++) {
+            Window& window = windows[w];
+            if(i < window.start) continue;
+
+            //The phase (in turns) of the sine wave at 'i' seconds is period * i / 60.
+            qint64 difference = reading - (sine((qint64) window.period * i / 60) + baseline);
+            qint64 currentError = (difference * difference) >> FRACTION_BITS;
+            if(currentError < window.minError) window.minError = currentError;
+            if(currentError > window.maxError) window.maxError = currentError;
+            window.errorSum += currentError;
+        }
+    }
+
+    //score = ceil((1 - error) * MAX_SCORE)
+    for(int w=0;w<windowCount;w++) {
+        qint32 scaled = (ONE - normalizeError(windows[w])) * MAX_SCORE;
+        scores[w] = (scaled + ONE - 1) >> FRACTION_BITS;
+    }
+    scratch.rewind(mark);
+}
+
+/*Purpose: Returns sin(2 * pi * 'turns') in Q16.16, where 'turns' is Q16.16. Only the fraction of 'turns' matters.*/
+qint32 FixedPointCoherenceEngine::sine(qint64 turns) {
+    const int remainderBits = FRACTION_BITS - SINE_TABLE_BITS;
+    qint32 fraction = (qint32) (turns & (ONE - 1));
+    int index = fraction >> remainderBits;
+    qint32 remainder = fraction & ((1 << remainderBits) - 1);
+
+    const qint32* table = tables().sine;
+    return table[index] + (((table[index + 1] - table[index]) * remainder) >> remainderBits);
+}
+
+/*  Purpose: Returns log2('x') in Q16.16 for a Q16.16 'x' > 0. The integer part comes from normalizing 'x' into [1, 2) and each bit of
+    the fraction from squaring it once.*/
+qint32 FixedPointCoherenceEngine::log2(qint32 x) {
+    qint32 result = 0;
+    while(x < ONE) {
+        x <<= 1;
+        result -= ONE;
+    }
+    while(x >= 2 * ONE) {
+        x >>= 1;
+        result += ONE;
+    }
+
+    for(qint32 bit = ONE >> 1;bit > 0;bit >>= 1) {
+        x = (qint32) (((qint64) x * x) >> FRACTION_BITS);
+        if(x >= 2 * ONE) {
+            x >>= 1;
+            result += bit;
+        }
+    }
+    return result;
+}
+
+/*Purpose: Returns 2^'x' in Q16.16 for a Q16.16 'x' <= 0. Results smaller than the smallest Q16.16 value are returned as 0.*/
+qint32 FixedPointCoherenceEngine::exp2(qint64 x) {
+    //Split 'x' into a whole number of halvings and a fraction in [0, 1) that is read from the table.
+    qint64 whole = x >= 0 ? x >> FRACTION_BITS : -((-x + ONE - 1) >> FRACTION_BITS);
+    qint32 fraction = (qint32) (x - whole * ONE);
+    if(whole < -FRACTION_BITS) return 0;
+
+    const int remainderBits = FRACTION_BITS - EXP2_TABLE_BITS;
+    int index = fraction >> remainderBits;
+    qint32 remainder = fraction & ((1 << remainderBits) - 1);
+    const qint32* table = tables().exp2;
+    qint32 value = table[index] + (((table[index + 1] - table[index]) * remainder) >> remainderBits);
+    return whole >= 0 ? value << whole : value >> -whole;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE FIXEDPOINTCOHERENCEENGINE CLASS***/
+
+/*  Purpose: Returns the normalized MSE of 'window' in Q16.16, increased if the period is not in the range of 3-15 cycles per minute.
+    A window whose errors are all equal is treated as a perfect fit (the float reference divides 0 by 0 there).*/
+qint32 FixedPointCoherenceEngine::normalizeError(const Window& window) {
+    if(window.maxError <= window.minError) return 0;
+    qint64 averageError = window.errorSum / window.size;
+    qint32 error = (qint32) (((averageError - window.minError) << FRACTION_BITS) / (window.maxError - window.minError));
+    error = qBound((qint32) 0, error, ONE);
+
+    //error^(1/d) = 2^(log2(error)/d) where d = (3 - period) * 8 or (period - 15) * 8.
+    qint64 penalty = 0;
+    if(window.period < 3 * ONE) penalty = (qint64) (3 * ONE - window.period) * 8;
+    else if(window.period > 15 * ONE) penalty = (qint64) (window.period - 15 * ONE) * 8;
+    if(penalty == 0 || error == 0) return error;
+    return exp2(((qint64) log2(error) << FRACTION_BITS) / penalty);
+}
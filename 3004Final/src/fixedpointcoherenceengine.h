@@ -0,0 +1,50 @@
+#ifndef FIXEDPOINTCOHERENCEENGINE_H
+#define FIXEDPOINTCOHERENCEENGINE_H
+
+#include <QtMath>
+#include <QtGlobal>
+#include <limits>
+#include "coherenceengine.h"
+
+/*  The FixedPointCoherenceEngine class computes the same coherence scores as the FloatCoherenceEngine using only integer arithmetic,
+    as the device would on a CPU without a floating point unit. Values are Q16.16 fixed point numbers (16 integer bits and 16 fraction
+    bits). The sine wave is read from a lookup table indexed by the phase in turns with linear interpolation, and the period penalty
+    x^(1/d) is computed as 2^(log2(x)/d) with an iterative fixed point log2 and a lookup table for 2^x.
+
+    Readings only become fixed point values once they enter the engine. The scores agree with the float reference within TOLERANCE.
+*/
+class FixedPointCoherenceEngine : public CoherenceEngine {
+
+    public:
+        static const int FRACTION_BITS = 16;
+        static const qint32 ONE = 1 << FRACTION_BITS;           //1.0 in Q16.16.
+        static const int SINE_TABLE_BITS = 10;                  //The sine table has 2^SINE_TABLE_BITS entries per turn.
+        static const int EXP2_TABLE_BITS = 8;                   //The 2^x table has 2^EXP2_TABLE_BITS entries for x in [0, 1].
+        static const int TOLERANCE = 1;                         //The most a score may differ from the float reference.
+
+        //Getter methods
+        QString getName();
+
+        void computeScores(const CoherenceInput& input, const int* windowLengths, int windowCount, float* scores, SessionArena& scratch);
+
+        //Fixed point helpers, public so the benchmark can check them against the float functions.
+        static qint32 sine(qint64 turns);
+        static qint32 log2(qint32 x);
+        static qint32 exp2(qint64 x);
+
+    private:
+        //The working state of one coherence window while the scores are computed.
+        struct Window {
+            int start;                                          //Index of the first reading in the window.
+            int size;                                           //Number of readings in the window.
+            qint32 period;                                      //Cycles per minute of the readings in the window (Q16.16).
+            qint64 minError;                                    //The errors are Q16.16 values held in 64 bits.
+            qint64 maxError;
+            qint64 errorSum;
+        };
+
+        //Helper methods
+        static qint32 normalizeError(const Window& window);
+};
+
+#endif // FIXEDPOINTCOHERENCEENGINE_H
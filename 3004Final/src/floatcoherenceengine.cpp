@@ -0,0 +1,76 @@
+#include "floatcoherenceengine.h"
+
+//Getter methods
+QString FloatCoherenceEngine::getName() {return "float";}
+
+/*  Purpose: Scores every window of 'input'. The period of each window comes from the running crossing counts, then the MSE between
+    each reading and the corresponding point on a perfect sine function with each window's period is computed in a single pass over the
+    readings of the longest window. Each reading is added to every window that contains it.*/
+void FloatCoherenceEngine::computeScores(const CoherenceInput& input, const int* windowLengths, int windowCount, float* scores,
+                                         SessionArena& scratch) {
+    //Every window is measured against the starting (baseline) value of the Session.
+    const float* readings = input.readings;
+    int sessionLength = input.sessionLength;
+    int baselineValue = readings[0];
+
+    //The per window state is scratch data, so it is taken from the arena and given back once the scores are computed.
+    SessionArena::Mark mark = scratch.getMark();
+    Window* windows = scratch.allocate<Window>(windowCount);
+    int firstReading = sessionLength;
+    for(int w=0;w<windowCount;w++) {
+        Window& window = windows[w];
+        int length = windowLengths[w];
+
+        //Windows longer than the Session so far cover every reading after the baseline.
+        if(sessionLength < length) window.start = 1;
+        else window.start = sessionLength - length + 1;
+        window.size = sessionLength - window.start + 1;
+        firstReading = qMin(firstReading, window.start);
+
+        //Calculate the period (cycles per minute) from the number of times the pulse value is equal to the baselineValue.
+        int numCrosses = input.crossingCounts[sessionLength] - input.crossingCounts[window.start - 1];
+        window.period = ((float) numCrosses / 2.0) / ((float) qMin(sessionLength, length) / 60.0);
+
+        window.minError = std::numeric_limits<float>::max();
+        window.maxError = 0;
+        window.averageError = 0;
+    }
+
+    for(int i=firstReading;i<=sessionLength;i++) {
+        for(int w=0;w<windowCount;w++) {
+            Window& window = windows[w];
+            if(i < window.start) continue;
+
+            //'i' is also the time (in seconds) at which the reading was observed.
+            float currentError = (float) qPow((readings[i] - (qSin(2.0 * (float) M_PI * window.period * (i / 60.0)) + baselineValue)), 2.0);
+            if(currentError < window.minError) window.minError = currentError;
+            if (currentError > window.maxError) window.maxError = currentError;
+            currentError = currentError / window.size;
+            window.averageError += currentError;
+        }
+    }
+
+    //Calculate the coherence score of every window.
+    for(int w=0;w<windowCount;w++) {
+        float error = normalizeError(windows[w]);
+        scores[w] = qCeil((1.0 - error) * (float) MAX_SCORE);
+    }
+    scratch.rewind(mark);
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE FLOATCOHERENCEENGINE CLASS***/
+
+/*  Purpose: This method is responsible for normalizing the Mean Squared Error accumulated for 'window' between its pulse data and a
+ *  perfect sine wave with the window's period.*/
+float FloatCoherenceEngine::normalizeError(const Window& window) {
+
+    //Normalize the error.
+    float averageError = (float) (window.averageError - window.minError) / (float) (window.maxError - window.minError);
+
+    //Increase the error if the period is not in the range of 3-15 cycles per minute.
+    float period = window.period;
+    if (period < 3) averageError = qPow(averageError, (1.0 / ((float)(3 - period) * 8.0)));
+    else if (period > 15) averageError = qPow(averageError, (1.0 / ((float) (period - 15) * 8.0)));
+
+    return averageError;
+}
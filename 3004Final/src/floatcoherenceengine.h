@@ -0,0 +1,35 @@
+#ifndef FLOATCOHERENCEENGINE_H
+#define FLOATCOHERENCEENGINE_H
+
+#include <QtMath>
+#include <limits>
+#include "coherenceengine.h"
+
+/*  The FloatCoherenceEngine class is the reference coherence scoring algorithm. Each window's period is found from the number of times
+    the pulse crossed the baseline, and its score from the normalized Mean Squared Error between the pulse and a sine wave with that
+    period. Every window is scored in a single pass over the readings of the longest window, using floating point math.
+*/
+class FloatCoherenceEngine : public CoherenceEngine {
+
+    public:
+        //Getter methods
+        QString getName();
+
+        void computeScores(const CoherenceInput& input, const int* windowLengths, int windowCount, float* scores, SessionArena& scratch);
+
+    private:
+        //The working state of one coherence window while the scores are computed.
+        struct Window {
+            int start;                                      //Index of the first reading in the window.
+            int size;                                       //Number of readings in the window.
+            float period;                                   //Cycles per minute of the readings in the window.
+            float minError;
+            float maxError;
+            float averageError;
+        };
+
+        //Helper methods
+        static float normalizeError(const Window& window);
+};
+
+#endif // FLOATCOHERENCEENGINE_H
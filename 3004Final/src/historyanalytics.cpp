@@ -0,0 +1,106 @@
+#include "historyanalytics.h"
+
+/***IMPLEMENTING THE HISTORYAGGREGATE STRUCT***/
+
+//Constructor for the HistoryAggregate struct. Every total starts at 0.
+HistoryAggregate::HistoryAggregate() {
+    this->sessionCount = 0;
+    this->scoredSessionCount = 0;
+    this->coherenceSum = 0;
+    this->achievementSum = 0;
+    this->lowTime = 0;
+    this->mediumTime = 0;
+    this->highTime = 0;
+}
+
+//Returns the mean of the average coherence of the Sessions in the group or 0 if there are none.
+float HistoryAggregate::getAverageCoherence() const {
+    if(this->scoredSessionCount == 0) return 0;
+    return this->coherenceSum / (float) this->scoredSessionCount;
+}
+
+//Returns the percentage of time spent in "Low", "Medium" and "High" coherence over every Session in the group.
+QMap<QString, float> HistoryAggregate::getCoherenceDistribution() const {
+    QMap<QString, float> timePercentages = QMap<QString, float>();
+    int coherenceSum = this->lowTime + this->mediumTime + this->highTime;
+    if(coherenceSum == 0) return timePercentages;
+
+    timePercentages["Low"] = ((float) this->lowTime / (float) coherenceSum) * 100.0;
+    timePercentages["Medium"] = ((float) this->mediumTime / (float) coherenceSum) * 100.0;
+    timePercentages["High"] = ((float) this->highTime / (float) coherenceSum) * 100.0;
+    return timePercentages;
+}
+
+/***IMPLEMENTING THE HISTORYANALYTICS CLASS***/
+
+//Constructor for the HistoryAnalytics class.
+HistoryAnalytics::HistoryAnalytics() {
+    this->days = QHash<qint64, HistoryAggregate>();
+    this->weeks = QHash<qint64, HistoryAggregate>();
+}
+
+//Getter methods
+HistoryAggregate HistoryAnalytics::getDay(QDate date) const {return this->days.value(date.toJulianDay());}
+HistoryAggregate HistoryAnalytics::getWeek(QDate date) const {return this->weeks.value(weekKey(date));}
+HistoryAggregate HistoryAnalytics::getTotal() const {return this->total;}
+
+/*  Purpose: Returns the mean average coherence of each of the 'weeks' weeks ending with the week containing 'lastWeek', oldest first.
+    Weeks without a Session have a value of 0.*/
+QVector<float> HistoryAnalytics::getWeeklyCoherenceTrend(QDate lastWeek, int weeks) const {
+    QVector<float> trend = QVector<float>();
+    for(int i=weeks - 1;i>=0;i--) trend.append(getWeek(lastWeek.addDays(-7 * i)).getAverageCoherence());
+    return trend;
+}
+
+//Setter methods
+
+/*Purpose: Adds the Session summarized by 'entry' to the day, week and total aggregates.*/
+void HistoryAnalytics::addSession(const HistoryEntry& entry) {
+    QDate date = entry.date.date();
+    apply(this->days[date.toJulianDay()], entry, 1);
+    apply(this->weeks[weekKey(date)], entry, 1);
+    apply(this->total, entry, 1);
+}
+
+/*Purpose: Removes the Session summarized by 'entry' from the day, week and total aggregates.*/
+void HistoryAnalytics::removeSession(const HistoryEntry& entry) {
+    QDate date = entry.date.date();
+    qint64 day = date.toJulianDay();
+    qint64 week = weekKey(date);
+    apply(this->days[day], entry, -1);
+    apply(this->weeks[week], entry, -1);
+    apply(this->total, entry, -1);
+
+    //Drop aggregates that no longer have any Sessions.
+    if(this->days[day].sessionCount == 0) this->days.remove(day);
+    if(this->weeks[week].sessionCount == 0) this->weeks.remove(week);
+}
+
+void HistoryAnalytics::clear() {
+    this->days.clear();
+    this->weeks.clear();
+    this->total = HistoryAggregate();
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE HISTORYANALYTICS CLASS***/
+
+//Weeks start on Monday.
+qint64 HistoryAnalytics::weekKey(QDate date) {
+    return date.toJulianDay() - (date.dayOfWeek() - 1);
+}
+
+/*Purpose: Adds (sign = 1) or removes (sign = -1) the Session summarized by 'entry' to or from 'aggregate'.*/
+void HistoryAnalytics::apply(HistoryAggregate& aggregate, const HistoryEntry& entry, int sign) {
+    aggregate.sessionCount += sign;
+    aggregate.achievementSum += sign * entry.achievementScore;
+    aggregate.lowTime += sign * entry.lowTime;
+    aggregate.mediumTime += sign * entry.mediumTime;
+    aggregate.highTime += sign * entry.highTime;
+
+    //Recall: The number of computed coherence scores is qFloor(sessionLength/5.0)
+    int scores = entry.sessionLength / 5;
+    if(scores > 0) {
+        aggregate.scoredSessionCount += sign;
+        aggregate.coherenceSum += sign * (entry.achievementScore / (float) scores);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef HISTORYANALYTICS_H
+#define HISTORYANALYTICS_H
+
+#include <QDate>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include "historystore.h"
+
+/*The HistoryAggregate struct holds running totals over a group of stored Sessions (a day, a week or the whole history).*/
+struct HistoryAggregate {
+    int sessionCount;                               //The number of Sessions in the group.
+    int scoredSessionCount;                         //The number of Sessions long enough to have at least one coherence score.
+    float coherenceSum;                             //The sum of the average coherence of every scored Session.
+    float achievementSum;                           //The sum of the achievement scores of every Session.
+    int lowTime;                                    //Total time spent in "Low" coherence (in seconds).
+    int mediumTime;                                 //Total time spent in "Medium" coherence (in seconds).
+    int highTime;                                   //Total time spent in "High" coherence (in seconds).
+
+    HistoryAggregate();
+    float getAverageCoherence() const;
+    QMap<QString, float> getCoherenceDistribution() const;
+};
+
+/*  The HistoryAnalytics class is responsible for answering statistics queries over a Profile's Session history. Instead of scanning the
+    history, it keeps an aggregate for every day and every week that has a Session, plus one for the whole history. The aggregates are
+    updated whenever a Session is added or removed, so every query for a day, a week or the whole history is answered in constant time.
+*/
+class HistoryAnalytics {
+
+    public:
+        //Constructor
+        HistoryAnalytics();
+
+        //Getter methods
+        HistoryAggregate getDay(QDate date) const;
+        HistoryAggregate getWeek(QDate date) const;
+        HistoryAggregate getTotal() const;
+        QVector<float> getWeeklyCoherenceTrend(QDate lastWeek, int weeks) const;
+
+        //Setter methods
+        void addSession(const HistoryEntry& entry);
+        void removeSession(const HistoryEntry& entry);
+        void clear();
+
+    private:
+        QHash<qint64, HistoryAggregate> days;           //Aggregates keyed by the Julian day of the Sessions.
+        QHash<qint64, HistoryAggregate> weeks;          //Aggregates keyed by the Julian day of the Monday of the Sessions' week.
+        HistoryAggregate total;                         //Aggregate of every Session in the history.
+
+        //Helper methods
+        static qint64 weekKey(QDate date);
+        static void apply(HistoryAggregate& aggregate, const HistoryEntry& entry, int sign);
+};
+
+#endif // HISTORYANALYTICS_H
@@ -0,0 +1,150 @@
+#include "historyindex.h"
+
+//Constructor for the HistoryQuery struct. The query matches every Session.
+HistoryQuery::HistoryQuery() {
+    this->challengeLevel = -1;
+    this->minAchievementScore = -std::numeric_limits<float>::infinity();
+    this->maxAchievementScore = std::numeric_limits<float>::infinity();
+    this->minAverageCoherence = -std::numeric_limits<float>::infinity();
+    this->maxAverageCoherence = std::numeric_limits<float>::infinity();
+}
+
+/*Purpose: Returns whether the query has no bounds (and so matches every Session).*/
+bool HistoryQuery::isEmpty() const {
+    return !this->from.isValid() && !this->to.isValid() && this->challengeLevel < 0
+            && this->minAchievementScore == -std::numeric_limits<float>::infinity()
+            && this->maxAchievementScore == std::numeric_limits<float>::infinity()
+            && this->minAverageCoherence == -std::numeric_limits<float>::infinity()
+            && this->maxAverageCoherence == std::numeric_limits<float>::infinity();
+}
+
+/*Purpose: Returns whether the Session summarized by 'entry' is within every bound of the query.*/
+bool HistoryQuery::matches(const HistoryEntry& entry) const {
+    if(this->from.isValid() && entry.date < this->from) return false;
+    if(this->to.isValid() && entry.date >= this->to) return false;
+    if(this->challengeLevel >= 0 && entry.challengeLevel != this->challengeLevel) return false;
+    if(entry.achievementScore < this->minAchievementScore || entry.achievementScore >= this->maxAchievementScore) return false;
+    float averageCoherence = HistoryIndex::getAverageCoherence(entry);
+    return averageCoherence >= this->minAverageCoherence && averageCoherence < this->maxAverageCoherence;
+}
+
+//Constructor for the HistoryIndex class.
+HistoryIndex::HistoryIndex() {}
+
+//Getter methods
+
+/*  Purpose: Returns the positions in the history of every Session matching 'query', in the order they were stored. 'entries' must be
+    the history the index was built from.*/
+QVector<int> HistoryIndex::query(const HistoryQuery& query, const QVector<HistoryEntry>& entries) const {
+    QVector<int> positions = QVector<int>();
+    if(query.isEmpty()) {
+        positions.reserve(entries.size());
+        for(int i=0;i<entries.size();i++) positions.append(i);
+        return positions;
+    }
+
+    //Find the range of every bounded key and keep the smallest.
+    double lows[NUM_KEYS] = {query.from.isValid() ? (double) query.from.toMSecsSinceEpoch() : -std::numeric_limits<double>::infinity(),
+                             query.challengeLevel >= 0 ? (double) query.challengeLevel : -std::numeric_limits<double>::infinity(),
+                             query.minAchievementScore, query.minAverageCoherence};
+    double highs[NUM_KEYS] = {query.to.isValid() ? (double) query.to.toMSecsSinceEpoch() : std::numeric_limits<double>::infinity(),
+                              query.challengeLevel >= 0 ? (double) query.challengeLevel + 1 : std::numeric_limits<double>::infinity(),
+                              query.maxAchievementScore, query.maxAverageCoherence};
+    QVector<IndexEntry>::const_iterator first = this->indexes[DateKey].constBegin(), last = this->indexes[DateKey].constEnd();
+    for(int key=0;key<NUM_KEYS;key++) {
+        QVector<IndexEntry>::const_iterator low = lowerBound((Key) key, lows[key]);
+        QVector<IndexEntry>::const_iterator high = lowerBound((Key) key, highs[key]);
+        if(high - low < last - first) {
+            first = low;
+            last = high;
+        }
+    }
+
+    //Check the other bounds on the Sessions in the smallest range.
+    for(QVector<IndexEntry>::const_iterator it = first;it != last;++it) {
+        if(query.matches(entries.at(it->position))) positions.append(it->position);
+    }
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+/*Purpose: Returns the position in the history of the Session recorded at 'date', or -1 if there is none.*/
+int HistoryIndex::find(const QDateTime& date) const {
+    double key = date.toMSecsSinceEpoch();
+    QVector<IndexEntry>::const_iterator it = lowerBound(DateKey, key);
+    if(it == this->indexes[DateKey].constEnd() || it->key != key) return -1;
+    return it->position;
+}
+
+/*Purpose: Returns the average coherence score of the Session summarized by 'entry', or 0 if it was too short to be scored.*/
+float HistoryIndex::getAverageCoherence(const HistoryEntry& entry) {
+    int scores = entry.sessionLength / 5;
+    return scores > 0 ? entry.achievementScore / scores : 0;
+}
+
+//Setter methods
+
+/*Purpose: Replaces every index with the indexes of 'entries', the Sessions of a whole history in the order they were stored.*/
+void HistoryIndex::build(const QVector<HistoryEntry>& entries) {
+    for(int key=0;key<NUM_KEYS;key++) {
+        QVector<IndexEntry>& index = this->indexes[key];
+        index.clear();
+        index.reserve(entries.size());
+        for(int i=0;i<entries.size();i++) {
+            IndexEntry indexEntry;
+            indexEntry.key = getKey(entries.at(i), (Key) key);
+            indexEntry.position = i;
+            index.append(indexEntry);
+        }
+        std::sort(index.begin(), index.end());
+    }
+}
+
+/*Purpose: Adds the Session summarized by 'entry', stored at 'position' in the history, to every index.*/
+void HistoryIndex::addSession(const HistoryEntry& entry, int position) {
+    for(int key=0;key<NUM_KEYS;key++) {
+        IndexEntry indexEntry;
+        indexEntry.key = getKey(entry, (Key) key);
+        indexEntry.position = position;
+        QVector<IndexEntry>& index = this->indexes[key];
+        index.insert(std::upper_bound(index.begin(), index.end(), indexEntry), indexEntry);
+    }
+}
+
+/*Purpose: Removes the Session at 'position' from every index and moves every later Session down one position.*/
+void HistoryIndex::removeSession(int position) {
+    for(int key=0;key<NUM_KEYS;key++) {
+        QVector<IndexEntry>& index = this->indexes[key];
+        int kept = 0;
+        for(int i=0;i<index.size();i++) {
+            if(index.at(i).position == position) continue;
+            index[kept] = index.at(i);
+            if(index.at(kept).position > position) index[kept].position--;
+            kept++;
+        }
+        index.resize(kept);
+    }
+}
+
+void HistoryIndex::clear() {
+    for(int key=0;key<NUM_KEYS;key++) this->indexes[key].clear();
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE HISTORYINDEX CLASS***/
+
+double HistoryIndex::getKey(const HistoryEntry& entry, Key key) {
+    switch(key) {
+        case DateKey: return entry.date.toMSecsSinceEpoch();
+        case ChallengeLevelKey: return entry.challengeLevel;
+        case AchievementScoreKey: return entry.achievementScore;
+        default: return getAverageCoherence(entry);
+    }
+}
+
+/*Purpose: Returns the first entry of index 'key' whose key is not less than 'value'.*/
+QVector<HistoryIndex::IndexEntry>::const_iterator HistoryIndex::lowerBound(Key key, double value) const {
+    const QVector<IndexEntry>& index = this->indexes[key];
+    return std::lower_bound(index.constBegin(), index.constEnd(), value, [](const IndexEntry& entry, double value) {
+        return entry.key < value;
+    });
+}
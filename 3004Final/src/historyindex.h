@@ -0,0 +1,72 @@
+#ifndef HISTORYINDEX_H
+#define HISTORYINDEX_H
+
+#include <QDateTime>
+#include <QVector>
+#include <limits>
+#include <algorithm>
+#include "historystore.h"
+
+/*  The HistoryQuery struct describes the stored Sessions to look for. Every bound is optional: dates are matched in [from, to), scores in
+    [min, max) and a challengeLevel of -1 matches any level. For example, "Sessions in March with challenge level 3 and an average
+    coherence of at least 2" sets 'from' and 'to' to the first of March and April, 'challengeLevel' to 3 and 'minAverageCoherence' to 2.
+*/
+struct HistoryQuery {
+    QDateTime from;                                 //The earliest date, or invalid for no lower bound.
+    QDateTime to;                                   //The date after the latest date, or invalid for no upper bound.
+    int challengeLevel;                             //The challenge level, or -1 for any.
+    float minAchievementScore;
+    float maxAchievementScore;
+    float minAverageCoherence;
+    float maxAverageCoherence;
+
+    HistoryQuery();
+    bool isEmpty() const;
+    bool matches(const HistoryEntry& entry) const;
+};
+
+/*  The HistoryIndex class keeps secondary indexes over a Profile's Session history so that a HistoryQuery does not scan the history.
+    There is one index per searchable key (date, challenge level, achievement score and average coherence), each a vector of
+    (key, position) pairs sorted by key. A query binary searches the range of every bounded key, walks only the smallest of those ranges
+    and checks the other bounds on each Session found, so it costs O(log n + k) where k is the size of the smallest range.
+
+    The indexes of a stored history are built at once and sorted a single time, in O(n log n). Adding a Session afterwards inserts into
+    each sorted vector, and removing one shifts the positions of the later Sessions down, which are O(n) moves of small entries. Both
+    happen once per user action, while queries run every time the filtered history is shown.
+*/
+class HistoryIndex {
+
+    public:
+        //The keys Sessions are indexed by.
+        enum Key {DateKey, ChallengeLevelKey, AchievementScoreKey, AverageCoherenceKey, NUM_KEYS};
+
+        //Constructor
+        HistoryIndex();
+
+        //Getter methods
+        QVector<int> query(const HistoryQuery& query, const QVector<HistoryEntry>& entries) const;
+        int find(const QDateTime& date) const;
+        static float getAverageCoherence(const HistoryEntry& entry);
+
+        //Setter methods
+        void build(const QVector<HistoryEntry>& entries);
+        void addSession(const HistoryEntry& entry, int position);
+        void removeSession(int position);
+        void clear();
+
+    private:
+        //One entry of an index: the key of the Session at 'position' in the history.
+        struct IndexEntry {
+            double key;
+            int position;
+            bool operator<(const IndexEntry& other) const {return key < other.key || (key == other.key && position < other.position);}
+        };
+
+        QVector<IndexEntry> indexes[NUM_KEYS];          //Sorted by (key, position).
+
+        //Helper methods
+        static double getKey(const HistoryEntry& entry, Key key);
+        QVector<IndexEntry>::const_iterator lowerBound(Key key, double value) const;
+};
+
+#endif // HISTORYINDEX_H
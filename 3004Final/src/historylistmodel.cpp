@@ -0,0 +1,161 @@
+#include "historylistmodel.h"
+
+//Constructor for the HistoryListModel class.
+HistoryListModel::HistoryListModel(Profile* profile, QObject* parent): QAbstractListModel(parent) {
+    this->profile = profile;
+    this->fetchedRows = 0;
+}
+
+/***IMPLEMENTING THE QABSTRACTLISTMODEL METHODS***/
+
+int HistoryListModel::rowCount(const QModelIndex& parent) const {
+    if(parent.isValid()) return 0;
+    return this->fetchedRows;
+}
+
+/*Purpose: Returns the name or the graph thumbnail of the Session at the given row, which are only created when the row is displayed.*/
+QVariant HistoryListModel::data(const QModelIndex& index, int role) const {
+    if(!index.isValid() || index.row() >= this->fetchedRows) return QVariant();
+    const QDateTime& date = this->profile->getSessionIndex().at(getPosition(index.row())).date;
+    if(role == Qt::DisplayRole) return date.toString("Session dd:MM:yyyy hh:mm:ss");
+    if(role != Qt::DecorationRole || this->missingThumbnails.contains(date.toMSecsSinceEpoch())) return QVariant();
+
+    QString path = this->profile->getThumbnailPath(date);
+    QPixmap thumbnail;
+    if(!QPixmapCache::find(path, &thumbnail)) {
+        if(!thumbnail.load(path)) {
+            this->missingThumbnails.insert(date.toMSecsSinceEpoch());      //Sessions saved before thumbnails existed have none.
+            return QVariant();
+        }
+        QPixmapCache::insert(path, thumbnail);
+    }
+    return thumbnail;
+}
+
+bool HistoryListModel::canFetchMore(const QModelIndex& parent) const {
+    if(parent.isValid()) return false;
+    return this->fetchedRows < totalRows();
+}
+
+/*Purpose: Makes up to FETCH_SIZE more rows available to the view.*/
+void HistoryListModel::fetchMore(const QModelIndex& parent) {
+    if(parent.isValid()) return;
+    int newRows = qMin(FETCH_SIZE, totalRows() - this->fetchedRows);
+    if(newRows <= 0) return;
+
+    beginInsertRows(QModelIndex(), this->fetchedRows, this->fetchedRows + newRows - 1);
+    this->fetchedRows += newRows;
+    endInsertRows();
+}
+
+//Getter methods
+
+//Returns the position in the Profile's history of the Session listed at 'row'.
+int HistoryListModel::getPosition(int row) const {
+    if(this->filter.isEmpty()) return row;
+    return this->filteredPositions.value(row, -1);
+}
+
+bool HistoryListModel::isFiltered() const {return !this->filter.isEmpty();}
+const HistoryQuery& HistoryListModel::getFilter() const {return this->filter;}
+
+//Setter methods
+
+/*Purpose: Lists the Session history of 'profile' instead. Called when the active Profile changes or its history is cleared.*/
+void HistoryListModel::setProfile(Profile* profile) {
+    beginResetModel();
+    this->profile = profile;
+    this->fetchedRows = 0;
+    this->missingThumbnails.clear();
+    this->filteredPositions = this->filter.isEmpty() ? QVector<int>() : profile->querySessions(this->filter);
+    endResetModel();
+}
+
+/*Purpose: Only lists the Sessions matching 'query' from now on. An empty query lists every Session again.*/
+void HistoryListModel::setFilter(const HistoryQuery& query) {
+    beginResetModel();
+    this->filter = query;
+    this->fetchedRows = 0;
+    this->filteredPositions = query.isEmpty() ? QVector<int>() : this->profile->querySessions(query);
+    endResetModel();
+}
+
+/*Purpose: Called after a Session was added to the end of the Profile's history. The row only appears once every earlier row was fetched.*/
+void HistoryListModel::sessionAdded() {
+    int position = this->profile->getSessionCount() - 1;
+    renderThumbnail(position);
+    if(!this->filter.isEmpty()) {
+        if(!this->filter.matches(this->profile->getSessionIndex().at(position))) return;
+        this->filteredPositions.append(position);
+    }
+    if(this->fetchedRows != totalRows() - 1) return;
+    beginInsertRows(QModelIndex(), this->fetchedRows, this->fetchedRows);
+    this->fetchedRows++;
+    endInsertRows();
+}
+
+/*Purpose: Called after the Session at 'position' was removed from the Profile's history.*/
+void HistoryListModel::sessionRemoved(int position) {
+    int row = getRow(position);
+    if(!this->filter.isEmpty()) {
+        //Every later Session moved down one position in the history.
+        for(int i=0;i<this->filteredPositions.size();i++) {
+            if(this->filteredPositions.at(i) > position) this->filteredPositions[i]--;
+        }
+        if(row >= 0) this->filteredPositions.removeAt(row);
+    }
+    if(row < 0 || row >= this->fetchedRows) return;
+    beginRemoveRows(QModelIndex(), row, row);
+    this->fetchedRows--;
+    endRemoveRows();
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE HISTORYLISTMODEL CLASS***/
+
+//Returns the number of rows the list has once every row is fetched.
+int HistoryListModel::totalRows() const {
+    if(this->filter.isEmpty()) return this->profile->getSessionCount();
+    return this->filteredPositions.size();
+}
+
+//Returns the row the Session at 'position' in the history is listed at, or -1 if it is not listed.
+int HistoryListModel::getRow(int position) const {
+    if(this->filter.isEmpty()) return position;
+    QVector<int>::const_iterator it = std::lower_bound(this->filteredPositions.constBegin(), this->filteredPositions.constEnd(), position);
+    if(it == this->filteredPositions.constEnd() || *it != position) return -1;
+    return it - this->filteredPositions.constBegin();
+}
+
+/*Purpose: Renders the thumbnail of the Session at 'position' on a worker thread and saves it next to the Profile's Session history.*/
+void HistoryListModel::renderThumbnail(int position) {
+    Log session = this->profile->getSessionAt(position);
+    QVector<float> pulseData = session.getPulseData();
+    QDateTime date = session.getDateTime();
+    QString path = this->profile->getThumbnailPath(date);
+    this->missingThumbnails.insert(date.toMSecsSinceEpoch());
+
+    Profile* renderedProfile = this->profile;
+    QFutureWatcher<void>* watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, renderedProfile, date]() {
+        thumbnailRendered(renderedProfile, date);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([pulseData, path]() {
+        if(!HrvPlot::renderThumbnail(pulseData).save(path, "PNG")) qWarning("Unable to save the thumbnail %s", qPrintable(path));
+    }));
+}
+
+/*  Purpose: Called on the GUI thread once the thumbnail of the Session started at 'date' was saved. Updates the Session's row, or deletes
+    the thumbnail if the Session was removed while it was being rendered.*/
+void HistoryListModel::thumbnailRendered(Profile* renderedProfile, QDateTime date) {
+    if(renderedProfile != this->profile) return;                    //The Profile was switched, so its rows are no longer listed.
+    this->missingThumbnails.remove(date.toMSecsSinceEpoch());
+
+    int position = this->profile->findSession(date);
+    if(position < 0) {
+        QFile::remove(this->profile->getThumbnailPath(date));
+        return;
+    }
+    int row = getRow(position);
+    if(row >= 0 && row < this->fetchedRows) emit dataChanged(this->index(row), this->index(row), {Qt::DecorationRole});
+}
@@ -0,0 +1,64 @@
+#ifndef HISTORYLISTMODEL_H
+#define HISTORYLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QSet>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include "profile.h"
+#include "hrvplot.h"
+
+/*  The HistoryListModel class is responsible for providing the entries of the "Review Session History" list to a QListView. Rows are
+    made available in pages of FETCH_SIZE through canFetchMore()/fetchMore(), and the text of a row is only created when the view asks
+    for it, so opening the list costs the same no matter how many Sessions are stored.
+
+    The list can be filtered with a HistoryQuery, in which case it only lists the matching Sessions (found with the Profile's indexes)
+    and each row maps to the position of its Session in the history.
+
+    Every row is decorated with a thumbnail of the Session's HRV graph. The thumbnail is rendered on a worker thread when the Session is
+    added and saved next to the Session's history, and loaded pixmaps are kept in the QPixmapCache.
+*/
+class HistoryListModel: public QAbstractListModel {
+
+    Q_OBJECT
+
+    public:
+        static const int FETCH_SIZE = 100;             //The number of rows made available by each call to fetchMore().
+
+        //Constructor
+        HistoryListModel(Profile* profile, QObject* parent=0);
+
+        //QAbstractListModel methods
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        bool canFetchMore(const QModelIndex& parent) const override;
+        void fetchMore(const QModelIndex& parent) override;
+
+        //Getter methods
+        int getPosition(int row) const;
+        bool isFiltered() const;
+        const HistoryQuery& getFilter() const;
+
+        //Setter methods
+        void setProfile(Profile* profile);
+        void setFilter(const HistoryQuery& query);
+        void sessionAdded();
+        void sessionRemoved(int position);
+
+    private:
+        Profile* profile;                               //The Profile whose Session history is listed.
+        int fetchedRows;                                //The number of rows that have been made available to the view.
+        mutable QSet<qint64> missingThumbnails;         //Dates (in ms) of Sessions known to have no thumbnail file.
+        HistoryQuery filter;                            //The Sessions listed, or an empty query to list every Session.
+        QVector<int> filteredPositions;                 //The positions of the listed Sessions if 'filter' is not empty.
+
+        //Helper methods
+        int totalRows() const;
+        int getRow(int position) const;
+        void renderThumbnail(int position);
+        void thumbnailRendered(Profile* renderedProfile, QDateTime date);
+};
+
+#endif // HISTORYLISTMODEL_H
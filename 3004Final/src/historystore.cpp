@@ -0,0 +1,272 @@
+#include "historystore.h"
+
+//Written at the start of every file so that files written by a different version of the store are not misread.
+static const quint32 STORE_MAGIC = 0x48525632;          //"HRV2", written at the start of every shard file.
+static const quint32 LEGACY_STORE_MAGIC = 0x48525631;   //"HRV1", shards of Logs written without a format version. Still read.
+static const quint32 INDEX_MAGIC = 0x48524932;          //"HRI2", written at the start of the index file.
+
+//Constructor for the HistoryStore class.
+HistoryStore::HistoryStore(QString directory) {
+    this->directory = QDir(directory);
+    this->directory.mkpath(".");
+    this->cachedShardNumber = -1;
+    this->cachedShardReadable = true;
+    this->accountedBytes = 0;
+    this->accountedObjects = 0;
+    loadIndex();
+    updateMemoryAccount();
+}
+
+//Destructor for the HistoryStore class.
+HistoryStore::~HistoryStore() {
+    MemoryStats::release(MemoryStats::History, this->accountedBytes, this->accountedObjects);
+}
+
+//Getter methods
+int HistoryStore::count() {return this->index.size();}
+const QVector<HistoryEntry>& HistoryStore::getIndex() {return this->index;}
+QString HistoryStore::getDirectory() {return this->directory.absolutePath();}
+
+/*Purpose: Returns the path of the graph thumbnail of the Session started at 'date'. The file only exists once the thumbnail was rendered.*/
+QString HistoryStore::getThumbnailPath(const QDateTime& date) {
+    return this->directory.filePath(QString("thumb_%1.png").arg(date.toMSecsSinceEpoch()));
+}
+
+/*Purpose: Returns the full Log of the Session at position 'index', loading its shard from disk if it is not the cached shard.*/
+Log HistoryStore::getSessionAt(int index) {
+    if(index < 0 || index >= this->index.size()) return Log();
+    QVector<Log>& shard = loadShard(index / SHARD_SIZE);
+    if(index % SHARD_SIZE >= shard.size()) return Log();        //The shard file is missing or damaged.
+    return shard.at(index % SHARD_SIZE);
+}
+
+//Setter methods
+
+/*Purpose: Adds a new Session to the end of the store. Returns -1 if a Session with the same date was already stored.*/
+int HistoryStore::append(Log session) {
+    for(int i=0;i<this->index.size();i++) {
+        if(this->index.at(i).date == session.getDateTime()) return -1;
+    }
+
+    //Add the Log to the last shard (which starts a new shard if the last one is full). A shard that cannot be read is never overwritten.
+    int shardNumber = this->index.size() / SHARD_SIZE;
+    QVector<Log>& shard = loadShard(shardNumber);
+    if(!this->cachedShardReadable) {
+        qWarning("Not adding to Session history shard %s, which cannot be read", qPrintable(shardPath(shardNumber)));
+        return -1;
+    }
+    shard.append(session);
+    saveShard(shardNumber, shard);
+
+    this->index.append(createEntry(session));
+    saveIndex();
+    updateMemoryAccount();
+    return 0;
+}
+
+/*  Purpose: Removes the Session at position 'index'. Every later shard is shifted down by one Log, one shard at a time, so that no
+    more than two shards are ever held in memory. Returns -1 if 'index' is invalid or a shard it would rewrite cannot be read.*/
+int HistoryStore::removeAt(int index) {
+    if(index < 0 || index >= this->index.size()) return -1;
+
+    int shardNumber = index / SHARD_SIZE;
+    int lastShard = (this->index.size() - 1) / SHARD_SIZE;
+    bool readable = true;
+    QVector<Log> current = readShard(shardNumber, &readable);
+    if(!readable || index % SHARD_SIZE >= current.size()) return -1;
+
+    //Nothing is moved unless every later shard can be read and holds as many Logs as the index says, so that a damaged shard is never
+    //overwritten. Removing is rare enough that reading the later shards twice is acceptable.
+    for(int later = shardNumber + 1;later <= lastShard;later++) {
+        int expected = later < lastShard ? SHARD_SIZE : this->index.size() - lastShard * SHARD_SIZE;
+        if(readShard(later, &readable).size() != expected || !readable) {
+            qWarning("Not removing from Session history, shard %s does not match the index", qPrintable(shardPath(later)));
+            return -1;
+        }
+    }
+    current.removeAt(index % SHARD_SIZE);
+
+    for(;shardNumber < lastShard;shardNumber++) {
+        QVector<Log> next = readShard(shardNumber + 1);
+        if(next.isEmpty()) break;
+        current.append(next.takeFirst());
+        saveShard(shardNumber, current);
+        current = next;
+    }
+    if(current.isEmpty()) QFile::remove(shardPath(shardNumber));
+    else saveShard(shardNumber, current);
+
+    QFile::remove(getThumbnailPath(this->index.at(index).date));
+    this->index.removeAt(index);
+    this->cachedShard.clear();
+    this->cachedShardNumber = -1;
+    saveIndex();
+    updateMemoryAccount();
+    return 0;
+}
+
+/*Purpose: Deletes every stored Session.*/
+void HistoryStore::clear() {
+    for(int i=0;i<=(this->index.size() - 1) / SHARD_SIZE;i++) QFile::remove(shardPath(i));
+    foreach(const HistoryEntry& entry, this->index) QFile::remove(getThumbnailPath(entry.date));
+    this->index.clear();
+    this->cachedShard.clear();
+    this->cachedShardNumber = -1;
+    saveIndex();
+    updateMemoryAccount();
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE HISTORYSTORE CLASS***/
+
+QString HistoryStore::shardPath(int shardNumber) {
+    return this->directory.filePath(QString("shard_%1.dat").arg(shardNumber));
+}
+
+/*  Purpose: Reads the index file of the store. If the index is missing or was written by a different version of the store, it is rebuilt
+    from the shard files.*/
+void HistoryStore::loadIndex() {
+    this->index.clear();
+    QFile file(this->directory.filePath("index.dat"));
+    if(!file.open(QIODevice::ReadOnly)) {
+        rebuildIndex();
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic;
+    qint32 size;
+    in >> magic >> size;
+    if(magic != INDEX_MAGIC || size < 0) {
+        rebuildIndex();
+        return;
+    }
+
+    this->index.reserve(size);
+    for(int i=0;i<size && in.status() == QDataStream::Ok;i++) {
+        HistoryEntry entry;
+        qint32 challengeLevel, sessionLength, lowTime, mediumTime, highTime;
+        in >> entry.date >> challengeLevel >> sessionLength >> entry.achievementScore >> lowTime >> mediumTime >> highTime;
+        entry.challengeLevel = challengeLevel;
+        entry.sessionLength = sessionLength;
+        entry.lowTime = lowTime;
+        entry.mediumTime = mediumTime;
+        entry.highTime = highTime;
+        this->index.append(entry);
+    }
+}
+
+/*Purpose: Recreates the index by reading every shard once. Only one shard is held in memory at a time.*/
+void HistoryStore::rebuildIndex() {
+    this->index.clear();
+    for(int shardNumber = 0;QFile::exists(shardPath(shardNumber));shardNumber++) {
+        QVector<Log> shard = readShard(shardNumber);
+        for(int i=0;i<shard.size();i++) this->index.append(createEntry(shard[i]));
+
+        //A partial shard must be the last one, otherwise the positions of the later Sessions would be wrong.
+        if(shard.size() < SHARD_SIZE) break;
+    }
+    if(!this->index.isEmpty()) saveIndex();
+}
+
+/*Purpose: Writes the index of the store to its index file.*/
+void HistoryStore::saveIndex() {
+    QFile file(this->directory.filePath("index.dat"));
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("Unable to write the Session history index to %s", qPrintable(file.fileName()));
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << INDEX_MAGIC << (qint32) this->index.size();
+    foreach(const HistoryEntry& entry, this->index) {
+        out << entry.date << (qint32) entry.challengeLevel << (qint32) entry.sessionLength << entry.achievementScore
+            << (qint32) entry.lowTime << (qint32) entry.mediumTime << (qint32) entry.highTime;
+    }
+}
+
+/*Purpose: Creates the index entry that summarizes 'session'.*/
+HistoryEntry HistoryStore::createEntry(Log session) {
+    HistoryEntry entry;
+    entry.date = session.getDateTime();
+    entry.challengeLevel = session.getChallengeLevel();
+    entry.sessionLength = session.getSessionLength();
+    entry.achievementScore = session.getAchievementScore();
+
+    QMap<QString, int> times = session.getCoherenceTimes();
+    entry.lowTime = times.value("Low", 0);
+    entry.mediumTime = times.value("Medium", 0);
+    entry.highTime = times.value("High", 0);
+    return entry;
+}
+
+/*Purpose: Returns the contents of shard 'shardNumber', replacing the cached shard if a different shard was cached.*/
+QVector<Log>& HistoryStore::loadShard(int shardNumber) {
+    if(this->cachedShardNumber != shardNumber) {
+        this->cachedShard = readShard(shardNumber, &this->cachedShardReadable);
+        this->cachedShardNumber = shardNumber;
+        updateMemoryAccount();
+    }
+    return this->cachedShard;
+}
+
+/*  Purpose: Reads shard 'shardNumber' from disk without touching the cached shard. A missing shard is returned as empty. A shard that
+    exists but cannot be parsed is also returned as empty, with 'readable' (if given) set to false so that it is not overwritten.*/
+QVector<Log> HistoryStore::readShard(int shardNumber, bool* readable) {
+    QVector<Log> logs = QVector<Log>();
+    if(readable != NULL) *readable = true;
+    QFile file(shardPath(shardNumber));
+    if(!file.open(QIODevice::ReadOnly)) return logs;
+
+    QDataStream in(&file);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic;
+    in >> magic;
+    if(magic == STORE_MAGIC) {
+        in >> logs;
+    } else if(magic == LEGACY_STORE_MAGIC) {
+        //Written as a QVector<Log> of unversioned Logs. It is rewritten in the current format the next time it is saved.
+        quint32 size;
+        in >> size;
+        for(quint32 i=0;i<size && in.status() == QDataStream::Ok;i++) {
+            Log log;
+            Log::readUnversioned(in, log);
+            logs.append(log);
+        }
+    } else {
+        in.setStatus(QDataStream::ReadCorruptData);
+    }
+
+    if(in.status() != QDataStream::Ok) {
+        qWarning("Session history shard %s cannot be read", qPrintable(file.fileName()));
+        logs.clear();
+        if(readable != NULL) *readable = false;
+    }
+    return logs;
+}
+
+/*Purpose: Writes 'logs' to the file for shard 'shardNumber', updating the cached shard if it is the one being written.*/
+void HistoryStore::saveShard(int shardNumber, const QVector<Log>& logs) {
+    QFile file(shardPath(shardNumber));
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("Unable to write Session history shard %s", qPrintable(file.fileName()));
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << STORE_MAGIC << logs;
+    if(this->cachedShardNumber == shardNumber && &logs != &this->cachedShard) this->cachedShard = logs;
+}
+
+/*Purpose: Updates MemoryStats with the change in the size of the index and the cached shard since the last update.*/
+void HistoryStore::updateMemoryAccount() {
+    qint64 bytes = this->index.capacity() * sizeof(HistoryEntry);
+    foreach(Log log, this->cachedShard) bytes += sizeof(Log) + log.getPulseData().capacity() * sizeof(float);
+    qint64 objects = this->cachedShard.size();
+
+    MemoryStats::allocate(MemoryStats::History, bytes - this->accountedBytes, objects - this->accountedObjects);
+    this->accountedBytes = bytes;
+    this->accountedObjects = objects;
+}
@@ -0,0 +1,70 @@
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <QString>
+#include <QVector>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include "log.h"
+#include "memorystats.h"
+
+/*The HistoryEntry struct is the small, always loaded summary of a stored Session. The full Log (with its pulse data) lives in a shard.*/
+struct HistoryEntry {
+    QDateTime date;                                 //The date the Session was recorded. Used as the Session's unique key.
+    int challengeLevel;                             //The challenge level used for the Session.
+    int sessionLength;                              //The length of the Session (in seconds).
+    float achievementScore;                         //The final achievement score of the Session.
+    int lowTime;                                    //Time spent in "Low" coherence (in seconds).
+    int mediumTime;                                 //Time spent in "Medium" coherence (in seconds).
+    int highTime;                                   //Time spent in "High" coherence (in seconds).
+};
+
+/*  The HistoryStore class is responsible for persistently storing the Session history of a single Profile in its own directory. Only the
+    index (one HistoryEntry per Session) is kept in memory. The full Logs are split into shard files of SHARD_SIZE Logs each, and at most
+    one shard is loaded at a time, so memory use does not grow with the length of the history.
+*/
+class HistoryStore {
+
+    public:
+        static const int SHARD_SIZE = 64;               //The number of Logs stored in each shard file.
+
+        //Constructor and destructor
+        HistoryStore(QString directory);
+        ~HistoryStore();
+
+        //Getter methods
+        int count();
+        const QVector<HistoryEntry>& getIndex();
+        Log getSessionAt(int index);
+        QString getDirectory();
+        QString getThumbnailPath(const QDateTime& date);
+
+        //Setter methods
+        int append(Log session);
+        int removeAt(int index);
+        void clear();
+
+    private:
+        QDir directory;                                 //The directory holding this store's index and shard files.
+        QVector<HistoryEntry> index;                    //One entry for every stored Session, in insertion order.
+        QVector<Log> cachedShard;                       //The contents of the most recently used shard.
+        int cachedShardNumber;                          //The number of the shard in 'cachedShard' or -1 if none is loaded.
+        bool cachedShardReadable;                       //False if the cached shard's file exists but could not be read.
+        qint64 accountedBytes;                          //The bytes of this store currently counted in MemoryStats.
+        qint64 accountedObjects;                        //The Logs of this store currently counted in MemoryStats.
+
+        //Helper methods
+        QString shardPath(int shardNumber);
+        void loadIndex();
+        void rebuildIndex();
+        void saveIndex();
+        HistoryEntry createEntry(Log session);
+        QVector<Log>& loadShard(int shardNumber);
+        QVector<Log> readShard(int shardNumber, bool* readable = NULL);
+        void saveShard(int shardNumber, const QVector<Log>& logs);
+        void updateMemoryAccount();
+};
+
+#endif // HISTORYSTORE_H
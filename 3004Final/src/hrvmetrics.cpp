@@ -0,0 +1,86 @@
+#include "hrvmetrics.h"
+
+//Constructor for the HrvMetrics class.
+HrvMetrics::HrvMetrics() {
+    reset();
+}
+
+//Getter methods
+int HrvMetrics::getSampleCount() const {return this->sampleCount;}
+float HrvMetrics::getMeanHeartRate() const {return this->meanHeartRate;}
+float HrvMetrics::getMinHeartRate() const {return this->sampleCount > 0 ? this->minHeartRate : 0;}
+float HrvMetrics::getMaxHeartRate() const {return this->sampleCount > 0 ? this->maxHeartRate : 0;}
+float HrvMetrics::getMeanInterval() const {return this->meanInterval;}
+
+/*Purpose: Returns the standard deviation of the NN intervals (ms), using the sample variance.*/
+float HrvMetrics::getSdnn() const {
+    if(this->sampleCount < 2) return 0;
+    return qSqrt(this->intervalM2 / (this->sampleCount - 1));
+}
+
+/*Purpose: Returns the root mean square of the differences between successive NN intervals (ms).*/
+float HrvMetrics::getRmssd() const {
+    if(this->sampleCount < 2) return 0;
+    return qSqrt(this->squaredDifferenceSum / (this->sampleCount - 1));
+}
+
+/*Purpose: Returns the percentage of successive NN intervals that differ by more than NN50_THRESHOLD.*/
+float HrvMetrics::getPnn50() const {
+    if(this->sampleCount < 2) return 0;
+    return 100.0 * this->nn50Count / (this->sampleCount - 1);
+}
+
+//Setter methods
+void HrvMetrics::reset() {
+    this->sampleCount = 0;
+    this->meanHeartRate = 0;
+    this->minHeartRate = std::numeric_limits<float>::max();
+    this->maxHeartRate = 0;
+    this->meanInterval = 0;
+    this->intervalM2 = 0;
+    this->lastInterval = 0;
+    this->squaredDifferenceSum = 0;
+    this->nn50Count = 0;
+}
+
+/*Purpose: Adds a heart rate reading (bpm) to the metrics. Readings that are not a valid heart rate are ignored.*/
+void HrvMetrics::addReading(float heartRate) {
+    if(!(heartRate > 0)) return;
+    double interval = 60000.0 / heartRate;                  //The NN interval (ms) of a beat at 'heartRate'.
+
+    this->sampleCount++;
+    this->meanHeartRate += (heartRate - this->meanHeartRate) / this->sampleCount;
+    this->minHeartRate = qMin(this->minHeartRate, heartRate);
+    this->maxHeartRate = qMax(this->maxHeartRate, heartRate);
+
+    //Welford's update keeps the variance numerically stable without storing the intervals.
+    double delta = interval - this->meanInterval;
+    this->meanInterval += delta / this->sampleCount;
+    this->intervalM2 += delta * (interval - this->meanInterval);
+
+    if(this->sampleCount > 1) {
+        double difference = interval - this->lastInterval;
+        this->squaredDifferenceSum += difference * difference;
+        if(qAbs(difference) > NN50_THRESHOLD) this->nn50Count++;
+    }
+    this->lastInterval = interval;
+}
+
+/***Implementing the stream operators for the HrvMetrics class***/
+
+/*Purpose: Writes the running state of 'metrics' to 'out' rather than the final values, so that no metric needs to be recomputed.*/
+QDataStream& operator<<(QDataStream& out, const HrvMetrics& metrics) {
+    out << (qint32) metrics.sampleCount << metrics.meanHeartRate << metrics.minHeartRate << metrics.maxHeartRate << metrics.meanInterval
+        << metrics.intervalM2 << metrics.lastInterval << metrics.squaredDifferenceSum << (qint32) metrics.nn50Count;
+    return out;
+}
+
+/*Purpose: Reads metrics that were written with operator<< from 'in'.*/
+QDataStream& operator>>(QDataStream& in, HrvMetrics& metrics) {
+    qint32 sampleCount, nn50Count;
+    in >> sampleCount >> metrics.meanHeartRate >> metrics.minHeartRate >> metrics.maxHeartRate >> metrics.meanInterval
+       >> metrics.intervalM2 >> metrics.lastInterval >> metrics.squaredDifferenceSum >> nn50Count;
+    metrics.sampleCount = sampleCount;
+    metrics.nn50Count = nn50Count;
+    return in;
+}
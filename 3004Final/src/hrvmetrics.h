@@ -0,0 +1,51 @@
+#ifndef HRVMETRICS_H
+#define HRVMETRICS_H
+
+#include <QtMath>
+#include <QDataStream>
+#include <limits>
+
+/*  The HrvMetrics class keeps the time-domain HRV metrics of a Session up to date as every (cleaned) heart rate reading arrives. Each
+    reading is converted to a beat-to-beat (NN) interval and folded into running sums: the mean and SDNN use Welford's method, RMSSD
+    and pNN50 use the successive interval differences. Every reading costs O(1) work and no allocations, and the metrics are read
+    without another pass over the pulse data.
+*/
+class HrvMetrics {
+
+    public:
+        static const int NN50_THRESHOLD = 50;                   //Successive intervals differing by more than this (ms) count for pNN50.
+
+        //Constructor
+        HrvMetrics();
+
+        //Getter methods
+        int getSampleCount() const;
+        float getMeanHeartRate() const;
+        float getMinHeartRate() const;
+        float getMaxHeartRate() const;
+        float getMeanInterval() const;
+        float getSdnn() const;
+        float getRmssd() const;
+        float getPnn50() const;
+
+        //Setter methods
+        void reset();
+        void addReading(float heartRate);
+
+    private:
+        int sampleCount;                                        //Number of readings added since the last reset.
+        double meanHeartRate;                                   //Running mean of the heart rate (bpm).
+        float minHeartRate;
+        float maxHeartRate;
+        double meanInterval;                                    //Running mean of the NN intervals (ms).
+        double intervalM2;                                      //Welford's sum of squared deviations from 'meanInterval'.
+        double lastInterval;                                    //The most recent NN interval (ms).
+        double squaredDifferenceSum;                            //Sum of the squared differences between successive intervals.
+        int nn50Count;                                          //Number of successive differences larger than NN50_THRESHOLD.
+
+        //Used to store the metrics in a Log.
+        friend QDataStream& operator<<(QDataStream& out, const HrvMetrics& metrics);
+        friend QDataStream& operator>>(QDataStream& in, HrvMetrics& metrics);
+};
+
+#endif // HRVMETRICS_H
@@ -0,0 +1,38 @@
+#include "hrvplot.h"
+
+/*Purpose: Returns an image of size 'size' with the whole of 'pulseData' drawn on a white background.*/
+QImage HrvPlot::renderThumbnail(const QVector<float>& pulseData, QSize size) {
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    paint(&painter, QRectF(1, 1, size.width() - 2, size.height() - 2), pulseData);
+    return image;
+}
+
+/*  Purpose: Draws 'pulseData' as a line stretched to fill 'area'. The lowest reading is drawn at the bottom of 'area' and the highest at
+    the top, so the shape of the rhythm is visible at any size.*/
+void HrvPlot::paint(QPainter* painter, const QRectF& area, const QVector<float>& pulseData) {
+    if(pulseData.size() < 2) return;
+
+    float minPulse = pulseData.at(0), maxPulse = pulseData.at(0);
+    for(int i=1;i<pulseData.size();i++) {
+        minPulse = qMin(minPulse, pulseData.at(i));
+        maxPulse = qMax(maxPulse, pulseData.at(i));
+    }
+    float range = qMax(maxPulse - minPulse, 1.0f);
+
+    QPolygonF line = QPolygonF();
+    line.reserve(pulseData.size());
+    for(int i=0;i<pulseData.size();i++) {
+        qreal x = area.left() + area.width() * i / (qreal) (pulseData.size() - 1);
+        qreal y = area.bottom() - area.height() * (pulseData.at(i) - minPulse) / range;
+        line.append(QPointF(x, y));
+    }
+
+    painter->save();
+    painter->setPen(QPen(Qt::black, 1));
+    painter->drawPolyline(line);
+    painter->restore();
+}
@@ -0,0 +1,23 @@
+#ifndef HRVPLOT_H
+#define HRVPLOT_H
+
+#include <QImage>
+#include <QPainter>
+#include <QPolygonF>
+#include <QVector>
+#include <QSize>
+
+/*  The HrvPlot class draws HRV graphs with a QPainter instead of a QGraphicsScene. A QImage can be painted on any thread, so the graphs
+    of stored Sessions can be rendered off the GUI thread (for example the thumbnails shown in the Session history).
+*/
+class HrvPlot {
+
+    public:
+        static const int THUMBNAIL_WIDTH = 96;          //The size (in pixels) of the thumbnail stored with every saved Session.
+        static const int THUMBNAIL_HEIGHT = 32;
+
+        static QImage renderThumbnail(const QVector<float>& pulseData, QSize size = QSize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT));
+        static void paint(QPainter* painter, const QRectF& area, const QVector<float>& pulseData);
+};
+
+#endif // HRVPLOT_H
@@ -16,6 +16,9 @@ Log::Log(){
     this->pulseData = QVector<float>();
     this->coherenceScore = -1;
     this->levelChanged = false;
+    this->rejectedSamples = 0;
+    this->windowScores = QVector<float>();
+    this->hrvMetrics = HrvMetrics();
 }
 
 /***Implementing the getter methods for the Log class***/
@@ -50,9 +53,14 @@ QString Log::getCoherenceLevel() {return this->coherenceLevel;}
 float Log::getAverageCoherence() {
     return this->achievementScore / (float)(qFloor(this->sessionLength / 5.0));         //Recall: The number of computed coherence scores
 }                                                                                       //is qFloor(this->sessionLength/5.0)
+QMap<QString, int> Log::getCoherenceTimes() {return this->coherenceTimes;}
 bool Log::isLevelChanged() {return this->levelChanged;}
+int Log::getRejectedSamples() {return this->rejectedSamples;}
+QVector<float> Log::getWindowScores() {return this->windowScores;}
+HrvMetrics Log::getHrvMetrics() {return this->hrvMetrics;}
 
 /***Implementing the setter methods for the Log class***/
+void Log::setDateTime(const QDateTime& date){this->date = date;}
 void Log::setChallengeLevel(int level){this->challengeLevel = level;}
 void Log::setPacerSpeed(int speed){this->breathPacerSpeed = speed;}
 void Log::setCoherenceTimes(QMap<QString, int> times){this->coherenceTimes = times;}
@@ -62,5 +70,55 @@ void Log::setPulseData(QVector<float> data){this->pulseData = data;}
 void Log::setCoherenceScore(float score){this->coherenceScore = score;}
 void Log::setCoherenceLevel(QString level){this->coherenceLevel = level;}
 void Log::setLevelChanged(bool isChanged){this->levelChanged = isChanged;}
+void Log::setRejectedSamples(int count){this->rejectedSamples = count;}
+void Log::setWindowScores(QVector<float> scores){this->windowScores = scores;}
+void Log::setHrvMetrics(HrvMetrics metrics){this->hrvMetrics = metrics;}
 
+/***Implementing the stream operators for the Log class***/
 
+/*Purpose: Writes every field of 'log' to 'out' so that the Log can be saved in a Profile's history store.*/
+QDataStream& operator<<(QDataStream& out, const Log& log) {
+    out << Log::FORMAT_VERSION << log.date << (qint32) log.challengeLevel << (qint32) log.breathPacerSpeed << log.coherenceTimes << (qint32) log.sessionLength
+        << log.achievementScore << log.pulseData << log.coherenceScore << log.coherenceLevel << log.levelChanged
+        << (qint32) log.rejectedSamples << log.windowScores << log.hrvMetrics;
+    return out;
+}
+
+/*Purpose: Reads a Log that was written with operator<< from 'in'.*/
+QDataStream& operator>>(QDataStream& in, Log& log) {
+    qint32 version;
+    in >> version;
+    if(version < 1 || version > Log::FORMAT_VERSION) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    Log::readFields(in, log, version);
+    return in;
+}
+
+/*  Purpose: Reads a Log written before the format version was stored with every Log (by the first, "HRV1", history store). Those Logs
+    have the fields of version 1.*/
+QDataStream& Log::readUnversioned(QDataStream& in, Log& log) {
+    readFields(in, log, 1);
+    return in;
+}
+
+/*Purpose: Reads the fields of a Log written with format 'version' from 'in'.*/
+void Log::readFields(QDataStream& in, Log& log, qint32 version) {
+    qint32 challengeLevel, pacerSpeed, sessionLength, rejectedSamples;
+    in >> log.date >> challengeLevel >> pacerSpeed >> log.coherenceTimes >> sessionLength
+       >> log.achievementScore >> log.pulseData >> log.coherenceScore >> log.coherenceLevel >> log.levelChanged
+       >> rejectedSamples;
+    log.challengeLevel = challengeLevel;
+    log.breathPacerSpeed = pacerSpeed;
+    log.sessionLength = sessionLength;
+    log.rejectedSamples = rejectedSamples;
+
+    //Logs written before the coherence windows were added have no window scores.
+    log.windowScores.clear();
+    if(version >= 2) in >> log.windowScores;
+
+    //Logs written before the HRV metrics were added have none (their sample count is 0).
+    log.hrvMetrics.reset();
+    if(version >= 3) in >> log.hrvMetrics;
+}
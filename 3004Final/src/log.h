@@ -6,6 +6,8 @@
 #include <QMap>
 #include <QVector>
 #include <QtMath>
+#include <QDataStream>
+#include "hrvmetrics.h"
 
 /*  Purpose: This class is meant to keep track of the data related to a Session. It is used both for storing data to be accessed
     during an active Session such as the pulse data and also for storing all of the data for a completed Session. In the first case,
@@ -14,6 +16,8 @@
 class Log {
 
     public:
+        static const qint32 FORMAT_VERSION = 3;         //Written before every stored Log. Increase it whenever a stored field is added.
+
         //Constructor and destructor
         Log();
 
@@ -29,9 +33,14 @@ class Log {
         float getCoherenceScore();
         QString getCoherenceLevel();
         float getAverageCoherence();
+        QMap<QString, int> getCoherenceTimes();
         bool isLevelChanged();
+        int getRejectedSamples();
+        QVector<float> getWindowScores();
+        HrvMetrics getHrvMetrics();
 
         //Setter methods.
+        void setDateTime(const QDateTime& date);
         void setChallengeLevel(int level);
         void setPacerSpeed(int speed);
         void setCoherenceTimes(QMap<QString, int> times);
@@ -41,6 +50,9 @@ class Log {
         void setCoherenceScore(float score);
         void setCoherenceLevel(QString level);
         void setLevelChanged(bool isChanged);
+        void setRejectedSamples(int count);
+        void setWindowScores(QVector<float> scores);
+        void setHrvMetrics(HrvMetrics metrics);
     private:
         QDateTime date;                                 //The date the session was recorded.
         int challengeLevel;                             //The challenge level used for the session.
@@ -52,6 +64,17 @@ class Log {
         float coherenceScore;                           //The current coherence score.
         QString coherenceLevel;                         //The current coherence level.
         bool levelChanged;                              //Whether or not the coherence level changed (device should beep if it did)
+        int rejectedSamples;                            //Number of sensor readings rejected as artifacts during the session.
+        QVector<float> windowScores;                    //Coherence score of each of Session::COHERENCE_WINDOWS (averages for a summary).
+        HrvMetrics hrvMetrics;                          //Time-domain HRV metrics of the session so far.
+
+        //Used to store a Log persistently.
+        friend QDataStream& operator<<(QDataStream& out, const Log& log);
+        friend QDataStream& operator>>(QDataStream& in, Log& log);
+        static void readFields(QDataStream& in, Log& log, qint32 version);
+
+    public:
+        static QDataStream& readUnversioned(QDataStream& in, Log& log);
 };
 
 #endif // LOG_H
@@ -1,11 +1,136 @@
 #include "mainwindow.h"
+#include "dashboard.h"
+#include "soakharness.h"
+#include "thresholdtuner.h"
+#include "coherencebench.h"
+#include "coherencecomparison.h"
+#include "sessionexporter.h"
+#include "streamreader.h"
+#include "tracer.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QStandardPaths>
+#include <QDir>
+
+//Returns whether 'name' is one of the command line arguments. Used to pick a tool that runs without the device's window.
+static bool hasArgument(int argc, char *argv[], const char* name) {
+    for(int i=1;i<argc;i++) {
+        if(qstrcmp(argv[i], name) == 0) return true;
+    }
+    return false;
+}
 
 int main(int argc, char *argv[])
 {
+    //"--tune-thresholds <seed> [streams]" searches for better CHALLENGE_THRESHOLDS tables.
+    if(hasArgument(argc, argv, "--tune-thresholds")) {
+        QCoreApplication a(argc, argv);
+        return ThresholdTuner::run(a.arguments());
+    }
+
+    //"--bench-coherence [seed] [streams]" measures a coherence update with each engine and checks the fixed point engine's scores.
+    if(hasArgument(argc, argv, "--bench-coherence")) {
+        QCoreApplication a(argc, argv);
+        return CoherenceBench::run(a.arguments());
+    }
+
+    //"--compare-coherence [engine] [seed] [streams] [--recorded]" replays the same streams through Sessions scoring with the float
+    //reference and with 'engine', and checks that the scores, levels and time in each level agree.
+    if(hasArgument(argc, argv, "--compare-coherence")) {
+        QCoreApplication a(argc, argv);
+        return CoherenceComparison::run(a.arguments());
+    }
+
+    //"--export <directory>" writes the summary of every stored Session to image files. It never creates a window, so it uses the
+    //offscreen platform unless another one was asked for.
+    if(hasArgument(argc, argv, "--export")) {
+        if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+        QGuiApplication a(argc, argv);
+        return SessionExporter::run(a.arguments());
+    }
+
+    //"--read-stream" prints the Session stream published by a device started with "--publish".
+    if(hasArgument(argc, argv, "--read-stream")) {
+        QCoreApplication a(argc, argv);
+        return StreamReader::run(a.arguments());
+    }
+
     QApplication a(argc, argv);
+    QStringList arguments = a.arguments();
+
+    //"--trace <file>" records a timeline of the run and writes it as a Chrome trace when the device exits.
+    int traceIndex = arguments.indexOf("--trace");
+    if(traceIndex >= 0) {
+        QString tracePath = arguments.value(traceIndex + 1);
+        if(tracePath.isEmpty()) {
+            qCritical("Usage: %s --trace <file>", argv[0]);
+            return 2;
+        }
+        if(!Tracer::isCompiledIn()) qWarning("Tracing is not compiled in, rebuild with CONFIG+=tracing to record events");
+        Tracer::setEnabled(true);
+        QObject::connect(&a, &QCoreApplication::aboutToQuit, [tracePath]() {
+            Tracer::setEnabled(false);
+            if(Tracer::writeChromeTrace(tracePath) && Tracer::getDroppedCount() > 0) {
+                qWarning("%lld trace events were dropped because a thread's buffer was full", Tracer::getDroppedCount());
+            }
+        });
+    }
+
+    //"--speed <1|10|100|max>" runs the device (or the dashboard or a soak run) that many times faster than real time from the start.
+    int speedIndex = arguments.indexOf("--speed");
+    if(speedIndex >= 0) {
+        int speed = SimClock::parseSpeed(arguments.value(speedIndex + 1));
+        if(speed < 0) {
+            qCritical("Usage: %s --speed <1|10|100|max>", argv[0]);
+            return 2;
+        }
+        SimClock::setSpeed(speed);
+    }
+
+    //"--soak <seed> <actions>" drives the device with a seeded random sequence of actions instead of waiting for the user.
+    int soakIndex = arguments.indexOf("--soak");
+    if(soakIndex >= 0) {
+        bool seedOk = false, actionsOk = false;
+        quint32 seed = arguments.value(soakIndex + 1).toUInt(&seedOk);
+        int actions = arguments.value(soakIndex + 2).toInt(&actionsOk);
+        if(!seedOk || !actionsOk || actions <= 0) {
+            qCritical("Usage: %s --soak <seed> <actions>", argv[0]);
+            return 2;
+        }
+
+        //Soak runs use their own, initially empty, data directory so they never touch the user's Profiles and are repeatable.
+        QStandardPaths::setTestModeEnabled(true);
+        QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).removeRecursively();
+        Session::setTickInterval(SoakHarness::TICK_INTERVAL);
+
+        MainWindow w;
+        w.show();
+        SoakHarness harness(&w, seed, actions);
+        QObject::connect(&harness, &SoakHarness::finished, &a, [](int failures) {QCoreApplication::exit(failures > 0 ? 1 : 0);});
+        QTimer::singleShot(0, &harness, &SoakHarness::start);
+        return a.exec();
+    }
+
+    //"--dashboard [participants]" monitors up to 64 participants at once instead of running the device.
+    int dashboardIndex = arguments.indexOf("--dashboard");
+    if(dashboardIndex >= 0) {
+        bool participantsOk = true;
+        int participants = Dashboard::DEFAULT_PARTICIPANTS;
+        QString value = arguments.value(dashboardIndex + 1);
+        if(!value.isEmpty() && !value.startsWith("--")) participants = value.toInt(&participantsOk);
+        if(!participantsOk || participants <= 0 || participants > Dashboard::MAX_PARTICIPANTS) {
+            qCritical("Usage: %s --dashboard [participants (1-%d)]", argv[0], (int) Dashboard::MAX_PARTICIPANTS);
+            return 2;
+        }
+        Dashboard dashboard(participants);
+        dashboard.show();
+        return a.exec();
+    }
+
     MainWindow w;
+    if(arguments.contains("--publish")) w.startPublishing();
     w.show();
     return a.exec();
 }
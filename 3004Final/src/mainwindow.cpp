@@ -22,6 +22,16 @@ MainWindow::MainWindow(QWidget *parent)
     this->linePen = new QPen(QColor("black"));
     this->linePen->setWidth(2);
 
+    //Repaints of the Session view are coalesced into frames.
+    this->lightLevel = "NA";
+    this->plottedPulses = 0;
+    renderScheduler = new RenderScheduler(RenderScheduler::DEFAULT_MAX_FPS, this);
+    connect(renderScheduler, &RenderScheduler::renderFrame, this, &MainWindow::renderSessionFrame);
+
+    //The breath pacer runs on its own clock while a Session is active.
+    breathPacer = new BreathPacer(BreathPacer::DEFAULT_MAX_FPS, this);
+    connect(breathPacer, &BreathPacer::pacerUpdated, this, &MainWindow::updateBreathPacer);
+
     //Connect the QPushButtons on the device's signals to their corresponding slots.
     connect(ui->powerButton, &QPushButton::pressed, this, &MainWindow::togglePowerOn);
     connect(ui->upButton, &QPushButton::pressed, this, &MainWindow::navigateUpMenu);
@@ -33,36 +43,97 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->backButton, &QPushButton::pressed, this, &MainWindow::goBack);
     connect(ui->sensorBox, &QComboBox::currentTextChanged, this, &MainWindow::sensorStateChanged);
 
-    //Create a new profile.
-    profile = new Profile(100);
+    //Load the Profiles on the device and make the last used Profile active.
+    profileManager = new ProfileManager(100);
+    profile = profileManager->getActiveProfile();
 
     //Setup for the batteryBar.
     ui->batteryBar->setValue(profile->getBatteryLevel());
-    batteryTimer = new QTimer(this);
-    connect(batteryTimer, &QTimer::timeout, this, &MainWindow::drainBattery);
+    powerModel = new PowerModel(profile->getBatteryLevel(), this);
+    connect(powerModel, &PowerModel::batteryLevelChanged, this, &MainWindow::updateBatteryLevel);
     connect(ui->rechargeButton, &QPushButton::pressed, this, &MainWindow::rechargeBattery);
+
+    //The Session history list pages its rows in from the active Profile's history.
+    historyModel = new HistoryListModel(profile, this);
+    ui->historyView->setModel(historyModel);
+    ui->historyView->setUniformItemSizes(true);
+    ui->historyView->setIconSize(QSize(HrvPlot::THUMBNAIL_WIDTH, HrvPlot::THUMBNAIL_HEIGHT));
+    this->summaryHistoryRow = -1;
+
+    //Summaries plot their full graph in chunks so that they can be shown at once.
+    summaryPlotTimer = new QTimer(this);
+    summaryPlotTimer->setInterval(0);
+    connect(summaryPlotTimer, &QTimer::timeout, this, &MainWindow::plotSummaryChunk);
+    this->summaryThumbnail = NULL;
+
+    //The underlying Session, Datagen and tree of Menus are created once and reused every time the device is turned on.
+    //CHANGE SESSION AND GENERATOR CONSTRUCTOR PARAMS. TO CHANGE COHERENCE (DEFAULT IS LOW)
+    currentSession = new Session(3, 10);                //Create the underlying Session.
+    generator = new Datagen("Low");                     //Low coherence to start.
+    connect(currentSession, &Session::getSensorReading, generator, &Datagen::getSensorReading);
+    connect(generator, &Datagen::sendSensorReading, currentSession, &Session::updatePulseData);
+    connect(generator, &Datagen::sendSensorReading, powerModel, [this]() {powerModel->chargeEvent(PowerModel::SensorSample);});
+    connect(currentSession, &Session::updateSessionDisplay, this, &MainWindow::plotPulsePoint);
+    connect(currentSession, &Session::sendSessionSummary, this, &MainWindow::displaySessionSummary);
+    streamPublisher = NULL;
+
+    //Every tick of the Session is journaled so that it survives the device losing power.
+    QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    journal = new SessionJournal(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/session.journal", this);
+    connect(currentSession, &Session::updateSessionDisplay, journal, &SessionJournal::record);
+
+    mainMenu = new Menu("Main Menu", {"Start New Session", "Settings", "History", "Profiles", "Diagnostics"}, NULL);
+    this->initializeMainMenu();                         //Creates the tree of menus, with root 'mainMenu'.
+    currMenu = mainMenu;
+    displayingMenu = false;
+    displayingSession = false;
+    displayingSummary = false;
+    displayingSlider = false;
+
+    //The scene is cleared and reused every time a Session or summary is displayed.
+    ui->hrvGraph->setAlignment(Qt::AlignLeft);          //Ensures the graph starts being drawn on the left side of the screen.
+    scene = new QGraphicsScene(ui->hrvGraph);
+    ui->hrvGraph->setScene(scene);
+    this->sceneBytes = 0;
+    this->sceneItems = 0;
 }
 
 MainWindow::~MainWindow()
 {
+    MemoryStats::dump();                                //Report the memory held by each subsystem on exit.
     delete ui;
-    delete batteryTimer;
-    delete profile;
+    delete powerModel;
+    delete profileManager;
     delete linePen;
     if(currentSession != NULL) delete currentSession;
     if(generator != NULL) delete generator;
     if(mainMenu != NULL) delete mainMenu;
     if(scene!=NULL) delete scene;
+    MemoryStats::release(MemoryStats::GraphScene, this->sceneBytes, this->sceneItems);
+
+}
 
+/*Purpose: Starts publishing every tick of the Session to the shared memory stream read by "--read-stream" (see StreamReader).*/
+void MainWindow::startPublishing() {
+    if(streamPublisher != NULL) return;
+    streamPublisher = new StreamPublisher(this);
+    connect(currentSession, &Session::updateSessionDisplay, streamPublisher, &StreamPublisher::publish);
+}
+
+/*Purpose: Reseeds the sensor readings so that a run (such as a soak run) produces the same readings every time for the same seed.*/
+void MainWindow::setSensorSeed(quint32 seed) {
+    generator->setSeed(seed);
 }
 
 /***IMPLEMENTING THE SLOTS FOR THE MAINWINDOW CLASS***/
 
-/*Purpose: This slot is called whenever the 'batteryTimer' emits a 'timeout' signal.*/
-void MainWindow::drainBattery() {
-    //Reduce the battery level by 5
-    profile->setBatteryLevel(profile->getBatteryLevel() - 5);
+/*Purpose: This slot is called whenever the 'powerModel' emits a 'batteryLevelChanged' signal.*/
+void MainWindow::updateBatteryLevel(int level) {
+    HRV_TRACE_COUNTER("Battery level (%)", level);
+    profile->setBatteryLevel(level);
     ui->batteryBar->setValue(profile->getBatteryLevel());
+    ui->batteryBar->setToolTip(QString("About %1 remaining")
+                               .arg(QDateTime::fromTime_t(powerModel->predictTimeToEmpty() / 1000).toUTC().toString("hh:mm:ss")));
 
     //Turn off the device if the battery level reaches 0.
     if(profile->getBatteryLevel() == 0 && this->powerOn) togglePowerOn();
@@ -70,13 +141,14 @@ void MainWindow::drainBattery() {
 
 /*Purpose: This slot is called whenever the 'Recharge Battery' button is pressed in the UI.*/
 void MainWindow::rechargeBattery() {
+    HRV_TRACE_SCOPE("Button: Recharge");
     //Refill battery to 100%
-    profile->setBatteryLevel(100);
-    ui->batteryBar->setValue(profile->getBatteryLevel());
+    powerModel->setBatteryLevel(100);
 }
 
 /*Purpose: This slot is called whever the QComboBox in the UI labeled 'Sensor' has its value changed.*/
 void MainWindow::sensorStateChanged(const QString& text) {
+    HRV_TRACE_SCOPE("Sensor changed");
     if(!QString::compare(text, "Off", Qt::CaseInsensitive)) {   //The Sensor is off
             ui->pulseIcon->setVisible(false);
 
@@ -91,40 +163,39 @@ void MainWindow::sensorStateChanged(const QString& text) {
     is on, it turns it off.
 */
 void MainWindow::togglePowerOn() {
+    HRV_TRACE_SCOPE("Button: Power");
     if(!this->powerOn) {//Turn on the device
         ui->powerOffView->setVisible(false);
-        this->powerOn = true;
         this->sessionActive = false;
 
-        //CHANGE SESSION AND GENERATOR CONSTRUCTOR PARAMS. TO CHANGE COHERENCE (DEFAULT IS LOW)
-        currentSession = new Session(3, 10);            //Create a new underlying Session.
-        generator = new Datagen("Low");                 //Low coherence to start.
-        connect(currentSession, &Session::getSensorReading, generator, &Datagen::getSensorReading);
-        connect(generator, &Datagen::sendSensorReading, currentSession, &Session::updatePulseData);
-        connect(currentSession, &Session::updateSessionDisplay, this, &MainWindow::plotPulsePoint);
-        connect(currentSession, &Session::sendSessionSummary, this, &MainWindow::displaySessionSummary);
-
-        //Create and display the main menu.
-        mainMenu = new Menu("Main Menu", {"Start New Session", "Settings", "History"}, NULL);
-        this->initializeMainMenu();                         //Creates the tree of menus, with root 'mainMenu'.
-
-        //Display the main menu
-        currMenu = mainMenu;
-        displayingMenu = true;
-        displayingSession = false;
-        displayingSummary = false;
-        displayingSlider = false;
-        this->displayCurrMenu();
+        //Return to the view, Settings and Profile the device was turned off with (or the Main Menu on the first power on).
+        this->restoreSnapshot();
+        this->powerOn = true;
+        this->recoverJournal();                         //Show the summary of a Session the device lost power during.
 
-        this->batteryTimer->start(30000);               //Start draining the battery every 30s that the device is on.
+        this->powerModel->start();                      //Start draining the battery while the device is on.
     }else{//Turn off the device
         ui->powerOffView->setVisible(true);
-        this->batteryTimer->stop();
+        this->powerModel->stop();
+        qInfo("Battery used by sensor samples: %.2f%%, redraws: %.2f%%, coherence computations: %.2f%%, beeps: %.2f%%",
+              powerModel->getEnergyUsed(PowerModel::SensorSample), powerModel->getEnergyUsed(PowerModel::Redraw),
+              powerModel->getEnergyUsed(PowerModel::CoherenceComputation), powerModel->getEnergyUsed(PowerModel::Beep));
+        this->saveSnapshot();
         this->powerOn = false;
+
+        //Discard an active Session, as if the "Back" button was pressed.
+        if(this->displayingSession) {
+            this->backOrMenu = true;
+            endSession();
+        }
         this->backOrMenu = false;
-        if(this->displayingSession) endSession();
-        mainMenu = NULL;
-        currMenu = NULL;
+        this->revertSessionView();
+        this->clearScreen();
+        displayingMenu = false;
+        displayingSession = false;
+        displayingSummary = false;
+        displayingSlider = false;
+        currMenu = mainMenu;
         sessionSummary = Log();
     }
 
@@ -132,19 +203,28 @@ void MainWindow::togglePowerOn() {
 
 /*Purpose: Navigates down a menu, called when the down button in the UI is pressed.*/
 void MainWindow::navigateDownMenu() {
+    HRV_TRACE_SCOPE("Button: Down");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     if(this->displayingMenu) {
-        int currIndex = ui->menuWidget->currentRow();
-        if(currIndex == (currMenu->getLists().size() - 1)) return;
-        ui->menuWidget->setCurrentRow(++currIndex);
+        int currIndex = currentMenuRow();
+
+        //Fetch the next page of the Session history when the end of the fetched rows is reached.
+        if(currIndex == (currentMenuSize() - 1) && currMenu->getMenuName() == "Review Session History" &&
+                historyModel->canFetchMore(QModelIndex())) historyModel->fetchMore(QModelIndex());
+
+        if(currIndex == (currentMenuSize() - 1)) return;
+        setCurrentMenuRow(++currIndex);
     }
 }
 
 /*Purpose: Navigates up a menu, called when the up button in the UI is pressed.*/
 void MainWindow::navigateUpMenu() {
+    HRV_TRACE_SCOPE("Button: Up");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     if(this->displayingMenu) {
-        int currIndex = ui->menuWidget->currentRow();
-        if(currIndex == 0) return;
-        ui->menuWidget->setCurrentRow(--currIndex);
+        int currIndex = currentMenuRow();
+        if(currIndex <= 0) return;
+        setCurrentMenuRow(--currIndex);
     }
 }
 
@@ -153,6 +233,8 @@ void MainWindow::navigateUpMenu() {
     the left arrow button in the UI is pressed.
 */
 void MainWindow::navigateLeft() {
+    HRV_TRACE_SCOPE("Button: Left");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     int currIndex = ui->keepSummary->currentRow();                          //The currently selected index.
     //Used to choose to keep or delete a Session summary.
     if(this->displayingSummary && currIndex > 0) {
@@ -172,6 +254,8 @@ void MainWindow::navigateLeft() {
     the right arrow button in the UI is pressed.
 */
 void MainWindow::navigateRight() {
+    HRV_TRACE_SCOPE("Button: Right");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     int currIndex = ui->keepSummary->currentRow();                          //The currently selected index.
     //Used to choose to keep or delete a Session summary.
     if(this->displayingSummary && currIndex < (ui->keepSummary->count()-1)) {
@@ -190,14 +274,27 @@ void MainWindow::navigateRight() {
  *  current view that the device is displaying.
 */
 void MainWindow::goToSubMenu() {
+    HRV_TRACE_SCOPE("Button: Selector");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
 
     //Handles the case where we are currently displaying a Menu
     if(this->displayingMenu) {
-        int subMenuIndex = ui->menuWidget->currentRow();
+        int subMenuIndex = currentMenuRow();
+
+        //Handles the case where the user has chosen to review a Session summary.
+        if(currMenu->getMenuName() == "Review Session History") {
+            if(subMenuIndex < 0) return;                    //There are no stored Sessions.
+            this->displayingMenu = false;
+            this->displayingSummary = true;
+            int position = historyModel->getPosition(subMenuIndex);
+            displaySessionSummary(profile->getSessionAt(position));
+            this->summaryHistoryRow = position;
+        }
 
         //Handles case where there user has selected a sub menu
-        if(currMenu->getSubMenuAt(subMenuIndex) != NULL) {
+        else if(currMenu->getSubMenuAt(subMenuIndex) != NULL) {
             currMenu = currMenu->getSubMenuAt(subMenuIndex);
+            updateGeneratedMenu();
             displayCurrMenu();
         } else {
 
@@ -217,21 +314,31 @@ void MainWindow::goToSubMenu() {
                 displaySettingView();
             }
 
-            //Handles the case where the user has chosen to review a Session summary.
-            else if(currMenu->getMenuName() == "Review Session History") {
-                this->displayingMenu = false;
-                this->displayingSummary = true;
-                displaySessionSummary(profile->getSessionHistory().at(subMenuIndex));
+            //Handles the case where the user has chosen to switch to (or add) a Profile.
+            else if(currMenu->getMenuName() == "Profiles") {
+                if(subMenuIndex == profileManager->getProfileNames().size()) {
+                    subMenuIndex = profileManager->addProfile(QString("User %1").arg(subMenuIndex + 1));
+                }
+                switchProfile(subMenuIndex);
+                currMenu = mainMenu;
+                displayCurrMenu();
             }
 
             //Handles the case where the user has chosen whether or not to clear all Session data on the device.
             else if(currMenu->getMenuName() == "Clear Session History") {
                 if(ui->menuWidget->currentRow() == 0) {
                     profile->resetDevice();
-                    mainMenu->getSubMenuAt(2)->getSubMenuAt(0)->clear();
+                    historyModel->setProfile(profile);
                 }
                 goBack();
             }
+
+            //Handles the case where the user has toggled one of the filters of the Session history.
+            else if(currMenu->getMenuName() == "Filter History") {
+                toggleHistoryFilter(subMenuIndex);
+                displayCurrMenu();
+                setCurrentMenuRow(subMenuIndex);
+            }
         }
     }
 
@@ -254,14 +361,12 @@ void MainWindow::goToSubMenu() {
         //If the user selected keep, then keep the summary.
         if(ui->keepSummary->currentRow() == 0){
             int failure = profile->addNewSession(this->sessionSummary);     //Ensures Session Logs are not added more than once
-            if(!failure) {
-                QString dateString = this->sessionSummary.getDateTime().toString("Session dd:MM:yyyy hh:mm:ss");
-                mainMenu->getSubMenuAt(2)->getSubMenuAt(0)->addListItem(dateString);
-            }
-        } else {    //Remove the summary
-            int failure = profile->removeSession(ui->menuWidget->currentRow());
-            if(!failure) mainMenu->getSubMenuAt(2)->getSubMenuAt(0)->removeitemAt(ui->menuWidget->currentRow());
+            if(!failure) historyModel->sessionAdded();
+        } else if(this->summaryHistoryRow >= 0) {    //Remove the summary if it was opened from the Session history
+            int failure = profile->removeSession(this->summaryHistoryRow);
+            if(!failure) historyModel->sessionRemoved(this->summaryHistoryRow);
         }
+        this->summaryHistoryRow = -1;
 
         //Need to reset all of the Session widgets
         this->revertSessionView();
@@ -276,6 +381,8 @@ void MainWindow::goToSubMenu() {
 
 /*Purpose: Returns the user to the main Menu whenever the 'Menu' button in the UI is pressed.*/
 void MainWindow::goToMainMenu() {
+    HRV_TRACE_SCOPE("Button: Menu");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     if(this->displayingSession) {
         //Discard whatever was recorded or changed during the session.
         this->revertSessionView();
@@ -289,6 +396,8 @@ void MainWindow::goToMainMenu() {
 
 /*Purpose: Sends the user to the previous screen they were on.*/
 void MainWindow::goBack() {
+    HRV_TRACE_SCOPE("Button: Back");
+    if(!this->powerOn) return;                                              //The buttons do nothing while the device is off.
     //Different behaviour if a Session is being displayed.
     if(this->displayingMenu) {
         if(currMenu->getPrevMenu()!=NULL) {
@@ -311,42 +420,91 @@ void MainWindow::goBack() {
     }
 }
 
-/*  Purpose: This method is called whenever the currentSession emits an updateSessionDisplay signal. It updates all of the metrics
-    and the graph in the Session view while a Session is active.*/
+/*  Purpose: This method is called whenever the currentSession emits an updateSessionDisplay signal. It updates the state behind the
+    Session view and requests a frame from the 'renderScheduler'. The widgets themselves are only updated in renderSessionFrame(), so any
+    number of updates between two frames cost a single repaint.*/
 void MainWindow::plotPulsePoint(Log currentLog) {
+    HRV_TRACE_SCOPE("Session display update");
+    this->latestLog = currentLog;
 
-    /*Update the breath pacer*/
-    if(currentLog.getSessionLength() != 0) {
-        if((currentLog.getSessionLength() % currentLog.getPacerSpeed()) <= qCeil((float)currentLog.getPacerSpeed() / 2.0) &&
-                (currentLog.getSessionLength() % currentLog.getPacerSpeed()) != 0) {
-            ui->breathPacer->setValue(ui->breathPacer->value() + qCeil(100.0 / (float) qFloor((float)currentLog.getPacerSpeed() / 2.0)));
-            ui->breathPacer->setFormat("Breathe In");
-        } else  {
-            ui->breathPacer->setValue(ui->breathPacer->value() - qCeil(100.0 / (float) qCeil((float)currentLog.getPacerSpeed() / 2.0)));
-            ui->breathPacer->setFormat("Breathe Out");
-        }
+    //Print the word ***BEEP*** if a new coherence level is reached.
+    if(currentLog.isLevelChanged()) {
+        qInfo("********************BEEP********************");
+        HRV_TRACE_INSTANT("BEEP");
+        powerModel->chargeEvent(PowerModel::Beep);
     }
 
-    /**Plot a new point on the graph.**/
-    plotHRVGraph(currentLog.getPulseData());
+    //Charge the battery for the coherence computation (done every 5 seconds).
+    if(currentLog.getSessionLength() != 0 && currentLog.getSessionLength() % 5 == 0) powerModel->chargeEvent(PowerModel::CoherenceComputation);
+
+    //Charge the battery for the redraw of this tick. In real time every tick is drawn in a frame of its own, so the redraws are charged
+    //per tick rather than per frame, which keeps the battery drain the same when the device is accelerated and frames hold many ticks.
+    powerModel->chargeEvent(PowerModel::Redraw);
+
+    renderScheduler->requestFrame();
+}
+
+/*  Purpose: This slot is called whenever the 'renderScheduler' emits a 'renderFrame' signal. It updates all of the metrics and the graph
+    in the Session view from the most recent Log while a Session is active.*/
+void MainWindow::renderSessionFrame() {
+    if(!this->sessionActive) return;
+    HRV_TRACE_SCOPE("Redraw");
+
+    /**Plot the points that are new since the last frame on the graph.**/
+    QVector<float> pulseData = this->latestLog.getPulseData();
+    plotHRVGraph(pulseData, this->plottedPulses);
+    this->plottedPulses = pulseData.size();
 
     /**Update the Session length.**/
-    QString time = QDateTime::fromTime_t(currentLog.getSessionLength()).toUTC().toString("mm:ss");
+    QString time = formatTime(this->latestLog.getSessionLength());
     ui->lengthNumber->display(time);
 
     /**Show the coherence data if it is available (will be -1 if not)**/
-    if(currentLog.getCoherenceScore() != -1) ui->coherenceNumber->display(currentLog.getCoherenceScore());
-    if(currentLog.getAchievementScore() != -1) ui->acheivementNumber->display(currentLog.getAchievementScore());
-    if(QString::compare(currentLog.getCoherenceLevel(), "NA", Qt::CaseInsensitive)) {
-
-        //Sets the light to red for 'Low', blue for 'Medium' and green for 'High'.
-        if(!QString::compare(currentLog.getCoherenceLevel(), "low", Qt::CaseInsensitive)) ui->coherenceLight->setStyleSheet("background-color: red;");
-        else if (!QString::compare(currentLog.getCoherenceLevel(), "medium", Qt::CaseInsensitive)) ui->coherenceLight->setStyleSheet("background-color: blue;");
+    if(this->latestLog.getCoherenceScore() != -1) ui->coherenceNumber->display(this->latestLog.getCoherenceScore());
+    if(this->latestLog.getAchievementScore() != -1) ui->acheivementNumber->display(this->latestLog.getAchievementScore());
+
+    //Sets the light to red for 'Low', blue for 'Medium' and green for 'High'. Restyling is only done when the level changes.
+    QString level = this->latestLog.getCoherenceLevel();
+    if(QString::compare(level, "NA", Qt::CaseInsensitive) && QString::compare(level, this->lightLevel, Qt::CaseInsensitive)) {
+        if(!QString::compare(level, "low", Qt::CaseInsensitive)) ui->coherenceLight->setStyleSheet("background-color: red;");
+        else if (!QString::compare(level, "medium", Qt::CaseInsensitive)) ui->coherenceLight->setStyleSheet("background-color: blue;");
         else ui->coherenceLight->setStyleSheet("background-color:green;");
+        this->lightLevel = level;
     }
 
-    //Print the word ***BEEP*** if a new coherence level is reached.
-    if(currentLog.isLevelChanged()) qInfo("********************BEEP********************");
+    //Update the coherence score of every window. The label is only changed when a new score was computed.
+    if(this->latestLog.getWindowScores() != this->shownWindowScores) showWindowScores(this->latestLog.getWindowScores());
+}
+
+/*  Purpose: Plots the next SUMMARY_PLOT_CHUNK points of the displayed summary's graph. Once the whole graph is plotted, the thumbnail that
+    was shown in its place is removed.*/
+void MainWindow::plotSummaryChunk() {
+    if(!this->displayingSummary) {
+        summaryPlotTimer->stop();
+        return;
+    }
+
+    int lastPoint = qMin(this->plottedPulses + SUMMARY_PLOT_CHUNK, this->summaryPulses.size());
+    plotHRVGraph(this->summaryPulses, this->plottedPulses, lastPoint);
+    this->plottedPulses = lastPoint;
+    if(lastPoint < this->summaryPulses.size()) return;
+
+    summaryPlotTimer->stop();
+    if(this->summaryThumbnail != NULL) {
+        QPixmap thumbnail = this->summaryThumbnail->pixmap();
+        qint64 thumbnailBytes = sizeof(QGraphicsPixmapItem) + thumbnail.width() * thumbnail.height() * 4;
+        MemoryStats::release(MemoryStats::GraphScene, thumbnailBytes, 1);
+        this->sceneBytes -= thumbnailBytes;
+        this->sceneItems--;
+        delete this->summaryThumbnail;
+        this->summaryThumbnail = NULL;
+    }
+}
+
+/*Purpose: This slot is called on every frame of the 'breathPacer' while a Session is active. It moves the breath pacer in the UI.*/
+void MainWindow::updateBreathPacer(int value, bool inhaling) {
+    ui->breathPacer->setValue(value);
+    ui->breathPacer->setFormat(inhaling ? "Breathe In" : "Breathe Out");
 }
 
 /*Purpose: This method is responsible for displaying a summary of a session once endSession() has been called.*/
@@ -354,9 +512,11 @@ void MainWindow::displaySessionSummary(Log summary) {
     if(!this->backOrMenu) {//Ensures that a summary is not displayed if the back button was pressed
         this->displayingSummary = true;
         this->sessionSummary = summary;                     //Used to save the Session data.
+        this->summaryHistoryRow = -1;                       //Set by the caller if the summary comes from the Session history.
         this->clearScreen();
         this->displaySessionView();
         ui->breathPacer->setVisible(false);
+        ui->windowScoresLabel->setVisible(false);           //The summary view takes its place.
         ui->summaryView->setVisible(true);
 
         /*Display the average coherence score*/
@@ -364,7 +524,7 @@ void MainWindow::displaySessionSummary(Log summary) {
         ui->coherenceNumber->display((double) summary.getAchievementScore() / qFloor( (float) summary.getSessionLength() / 5.0));
 
         /*Display the Session Length*/
-        QString time = QDateTime::fromTime_t(summary.getSessionLength()).toUTC().toString("mm:ss");
+        QString time = formatTime(summary.getSessionLength());
         ui->lengthNumber->display(time);
 
         /*Display the achievement score*/
@@ -378,8 +538,28 @@ void MainWindow::displaySessionSummary(Log summary) {
         ui->mediumLabel->setText(QString("Medium: %1%").arg(summary.getCoherenceDistribution()["Medium"]));
         ui->highLabel->setText(QString("High: %1%").arg(summary.getCoherenceDistribution()["High"]));
 
-        /*Plot the final HRV graph*/
-        plotHRVGraph(summary.getPulseData());
+        /*Display the time-domain HRV metrics that the Session kept while it ran*/
+        HrvMetrics metrics = summary.getHrvMetrics();
+        if(metrics.getSampleCount() > 0) {
+            ui->hrvMetricsLabel->setText(QString("HR: %1 (%2-%3)  SDNN: %4ms  RMSSD: %5ms  pNN50: %6%")
+                                         .arg(metrics.getMeanHeartRate(), 0, 'f', 1).arg(qRound(metrics.getMinHeartRate()))
+                                         .arg(qRound(metrics.getMaxHeartRate())).arg(metrics.getSdnn(), 0, 'f', 1)
+                                         .arg(metrics.getRmssd(), 0, 'f', 1).arg(metrics.getPnn50(), 0, 'f', 1));
+        } else ui->hrvMetricsLabel->setText("No HRV metrics were recorded for this Session");
+        ui->hrvMetricsLabel->setVisible(true);
+
+        /*Show the stored thumbnail of the HRV graph, if there is one, while the full graph is plotted*/
+        QPixmap thumbnail(profile->getThumbnailPath(summary.getDateTime()));
+        if(!thumbnail.isNull()) {
+            thumbnail = thumbnail.scaled(ui->hrvGraph->viewport()->width(), scene->sceneRect().height());
+            this->summaryThumbnail = scene->addPixmap(thumbnail);
+            qint64 thumbnailBytes = sizeof(QGraphicsPixmapItem) + thumbnail.width() * thumbnail.height() * 4;
+            MemoryStats::allocate(MemoryStats::GraphScene, thumbnailBytes, 1);
+            this->sceneBytes += thumbnailBytes;
+            this->sceneItems++;
+        }
+        this->summaryPulses = summary.getPulseData();
+        summaryPlotTimer->start();
 
         //Select the leftmost option in the set of options that decide whether to keep the summary that is displayed.
         ui->keepSummary->setCurrentRow(0);
@@ -392,18 +572,115 @@ void MainWindow::displaySessionSummary(Log summary) {
 void MainWindow::initializeMainMenu() {
 
     //Create the Settings menu.
-    Menu* settings = new Menu("Settings", {"Challenge Level", "Breath Pacer Speed"}, mainMenu);
+    Menu* settings = new Menu("Settings", {"Challenge Level", "Breath Pacer Speed", "Simulation Speed"}, mainMenu);
 
     //Create the History (logs) menu.
-    Menu* history = new Menu("History", {"Review Session History", "Clear Session History"}, mainMenu);
+    Menu* history = new Menu("History", {"Review Session History", "Clear Session History", "Statistics", "Filter History"}, mainMenu);
     Menu* reviewHistory = new Menu("Review Session History", {}, history);
     Menu* clearHistory = new Menu("Clear Session History", {"Yes", "No"}, history);
+    Menu* statistics = new Menu("Statistics", {}, history);
+    Menu* filterHistory = new Menu("Filter History", {}, history);
+
+    //Create the Profiles menu, which lists every Profile on the device followed by an entry for adding a new one.
+    Menu* profiles = new Menu("Profiles", profileManager->getProfileNames() << "Add Profile", mainMenu);
+
+    //Create the Diagnostics menu, which is filled in when it is opened.
+    Menu* diagnostics = new Menu("Diagnostics", {}, mainMenu);
 
     history->addSubMenu(reviewHistory);
     history->addSubMenu(clearHistory);
+    history->addSubMenu(statistics);
+    history->addSubMenu(filterHistory);
     mainMenu->addSubMenu(NULL);            //NULL is used to indicate that the "Start New Session" menu entry does not lead to a menu.
     mainMenu->addSubMenu(settings);
     mainMenu->addSubMenu(history);
+    mainMenu->addSubMenu(profiles);
+    mainMenu->addSubMenu(diagnostics);
+}
+
+/*  Purpose: This method is responsible for making the Profile at position 'index' the active Profile and updating the Session history
+    list and Profiles menu to match it.*/
+void MainWindow::switchProfile(int index) {
+    profile = profileManager->switchProfile(index);
+    historyModel->setProfile(profile);
+
+    Menu* profiles = mainMenu->getSubMenuAt(3);
+    profiles->clear();
+    foreach(QString name, profileManager->getProfileNames()) profiles->addListItem(name);
+    profiles->addListItem("Add Profile");
+}
+
+/*Purpose: Fills in 'currMenu' if it is one of the Menus whose items are generated when it is opened.*/
+void MainWindow::updateGeneratedMenu() {
+    if(currMenu->getMenuName() == "Statistics") updateStatisticsMenu();
+    else if(currMenu->getMenuName() == "Filter History") updateFilterMenu();
+    else if(currMenu->getMenuName() == "Diagnostics") updateDiagnosticsMenu();
+}
+
+/*Purpose: This method is responsible for filling the Diagnostics menu with the memory currently held by each subsystem.*/
+void MainWindow::updateDiagnosticsMenu() {
+    Menu* diagnostics = mainMenu->getSubMenuAt(4);
+    diagnostics->clear();
+    foreach(QString line, MemoryStats::getReport()) diagnostics->addListItem(line);
+}
+
+/*  Purpose: This method is responsible for filling the Statistics menu with the active Profile's statistics for today, this week and
+    the whole history. Every value comes from the Profile's precomputed aggregates.*/
+void MainWindow::updateStatisticsMenu() {
+    const HistoryAnalytics& analytics = profile->getAnalytics();
+    QDate today = QDate::currentDate();
+    HistoryAggregate day = analytics.getDay(today);
+    HistoryAggregate week = analytics.getWeek(today);
+    HistoryAggregate total = analytics.getTotal();
+    QMap<QString, float> weekDistribution = week.getCoherenceDistribution();
+
+    QString trend = "Last 4 weeks:";
+    foreach(float coherence, analytics.getWeeklyCoherenceTrend(today, 4)) trend += QString(" %1").arg(coherence, 0, 'f', 1);
+
+    Menu* statistics = mainMenu->getSubMenuAt(2)->getSubMenuAt(2);
+    statistics->clear();
+    statistics->addListItem(QString("Today: %1 sessions, avg. %2").arg(day.sessionCount).arg(day.getAverageCoherence(), 0, 'f', 1));
+    statistics->addListItem(QString("This week: %1 sessions, avg. %2").arg(week.sessionCount).arg(week.getAverageCoherence(), 0, 'f', 1));
+    statistics->addListItem(QString("This week's achievement: %1").arg(week.achievementSum));
+    statistics->addListItem(QString("This week: L %1% M %2% H %3%").arg(weekDistribution["Low"], 0, 'f', 0)
+                            .arg(weekDistribution["Medium"], 0, 'f', 0).arg(weekDistribution["High"], 0, 'f', 0));
+    statistics->addListItem(trend);
+    statistics->addListItem(QString("All time: %1 sessions, avg. %2").arg(total.sessionCount).arg(total.getAverageCoherence(), 0, 'f', 1));
+}
+
+/*  Purpose: This method is responsible for filling the Filter History menu with the filters that can be applied to the Session history,
+    each marked with whether it is applied.*/
+void MainWindow::updateFilterMenu() {
+    const HistoryQuery& filter = historyModel->getFilter();
+    Menu* filterHistory = mainMenu->getSubMenuAt(2)->getSubMenuAt(3);
+    filterHistory->clear();
+    filterHistory->addListItem(QString(filter.from.isValid() ? "[x]" : "[ ]") + " This Month");
+    filterHistory->addListItem(QString(filter.challengeLevel >= 0 ? "[x]" : "[ ]") + " Current Challenge Level");
+    filterHistory->addListItem(QString(filter.minAverageCoherence >= 2 ? "[x]" : "[ ]") + " Average Coherence 2+");
+    filterHistory->addListItem(QString(filter.minAchievementScore >= 50 ? "[x]" : "[ ]") + " Achievement Score 50+");
+    filterHistory->addListItem("Clear Filters");
+}
+
+/*  Purpose: This method is responsible for applying (or removing) the filter at 'row' of the Filter History menu to the Session history
+    and updating the menu to match.*/
+void MainWindow::toggleHistoryFilter(int row) {
+    HistoryQuery filter = historyModel->getFilter();
+    if(row == 0) {
+        QDate firstDay = QDate::currentDate();
+        firstDay.setDate(firstDay.year(), firstDay.month(), 1);
+        filter.from = filter.from.isValid() ? QDateTime() : QDateTime(firstDay, QTime(0, 0));
+        filter.to = filter.to.isValid() ? QDateTime() : QDateTime(firstDay.addMonths(1), QTime(0, 0));
+    } else if(row == 1) {
+        filter.challengeLevel = filter.challengeLevel >= 0 ? -1 : currentSession->getChallengeLevel();
+    } else if(row == 2) {
+        filter.minAverageCoherence = filter.minAverageCoherence >= 2 ? -std::numeric_limits<float>::infinity() : 2;
+    } else if(row == 3) {
+        filter.minAchievementScore = filter.minAchievementScore >= 50 ? -std::numeric_limits<float>::infinity() : 50;
+    } else {
+        filter = HistoryQuery();
+    }
+    historyModel->setFilter(filter);
+    updateFilterMenu();
 }
 
 /*  Purpose: This method is responsible for clearing the screen so that a new view may be displayed. */
@@ -419,6 +696,7 @@ void MainWindow::clearScreen() {
     ui->summaryView->setVisible(false);
     ui->settingsView->setVisible(false);
     ui->menuWidget->setVisible(false);
+    ui->historyView->setVisible(false);
 }
 
 /*Purpose: Resets all of the widgets related to the Session metrics.
@@ -427,7 +705,7 @@ void MainWindow::revertSessionView() {
     ui->coherenceLabel->setText("Coherence");
     ui->coherenceNumber->display(0);
     ui->acheivementNumber->display(0);
-    ui->lengthNumber->display(QDateTime::fromTime_t(0).toUTC().toString("mm:ss"));
+    ui->lengthNumber->display(formatTime(0));
     ui->breathPacer->setVisible(true);
     ui->breathPacer->setValue(0);
     ui->breathPacer->setFormat("Breath Pacer");
@@ -441,12 +719,146 @@ void MainWindow::displayCurrMenu() {
     ui->menuLabel->setText(currMenu->getMenuName());
     ui->menuLabel->setVisible(true);
 
+    //The Session history is listed by the 'historyModel', which only creates the rows that are displayed.
+    if(currMenu->getMenuName() == "Review Session History") {
+        setCurrentMenuRow(0);
+        ui->historyView->setVisible(true);
+        return;
+    }
+
     ui->menuWidget->clear();
     ui->menuWidget->addItems(currMenu->getLists());
     ui->menuWidget->setCurrentRow(0);
     ui->menuWidget->setVisible(true);
 }
 
+/*Purpose: Returns the selected row of the list displaying 'currMenu' or -1 if nothing is selected.*/
+int MainWindow::currentMenuRow() {
+    if(currMenu->getMenuName() == "Review Session History") return ui->historyView->currentIndex().row();
+    return ui->menuWidget->currentRow();
+}
+
+/*Purpose: Returns the number of rows in the list displaying 'currMenu'.*/
+int MainWindow::currentMenuSize() {
+    if(currMenu->getMenuName() == "Review Session History") return historyModel->rowCount();
+    return currMenu->getLists().size();
+}
+
+/*Purpose: Selects 'row' in the list displaying 'currMenu'.*/
+void MainWindow::setCurrentMenuRow(int row) {
+    if(currMenu->getMenuName() == "Review Session History") ui->historyView->setCurrentIndex(historyModel->index(row));
+    else ui->menuWidget->setCurrentRow(row);
+}
+
+/*  Purpose: This method is responsible for saving the current view, Settings and Profile of the device so that they can
+    be restored the next time it is turned on.*/
+void MainWindow::saveSnapshot() {
+    DeviceSnapshot snapshot = DeviceSnapshot();
+    for(Menu* menu = currMenu; menu != NULL && menu != mainMenu; menu = menu->getPrevMenu()) snapshot.menuPath.prepend(menu->getMenuName());
+
+    //An active Session is restored as the Menu it was started from.
+    if(this->displayingMenu || this->displayingSlider) snapshot.selectedRow = currentMenuRow();
+    if(this->displayingSlider) snapshot.view = DeviceSnapshot::SliderView;
+    else if(this->displayingSummary) {
+        snapshot.view = DeviceSnapshot::SummaryView;
+        snapshot.summary = this->sessionSummary;
+        snapshot.summaryHistoryRow = this->summaryHistoryRow;
+    }
+
+    snapshot.challengeLevel = currentSession->getChallengeLevel();
+    snapshot.pacerSpeed = currentSession->getPacerSpeed();
+    snapshot.profileIndex = profileManager->getActiveIndex();
+    if(!snapshot.save(snapshotPath())) qWarning("Unable to write the device snapshot to %s", qPrintable(snapshotPath()));
+}
+
+/*  Purpose: This method is responsible for restoring the device to the state saved by saveSnapshot(). If there is no snapshot, the
+    device starts on the Main Menu with the default Settings.*/
+void MainWindow::restoreSnapshot() {
+    QElapsedTimer restoreTime;
+    restoreTime.start();
+    DeviceSnapshot snapshot = DeviceSnapshot();
+    if(!snapshot.load(snapshotPath())) snapshot = DeviceSnapshot();
+
+    if(snapshot.profileIndex != profileManager->getActiveIndex()) switchProfile(snapshot.profileIndex);
+    currentSession->setChallengeLevel(snapshot.challengeLevel);
+    currentSession->setPacerSpeed(snapshot.pacerSpeed);
+
+    //Follow the saved path through the tree of Menus, stopping at the first Menu that no longer exists.
+    currMenu = mainMenu;
+    foreach(QString name, snapshot.menuPath) {
+        int index = currMenu->getLists().indexOf(name);
+        if(index < 0 || currMenu->getSubMenuAt(index) == NULL) break;
+        currMenu = currMenu->getSubMenuAt(index);
+    }
+
+    //Display the saved Menu and select the saved row, fetching rows of the Session history until it is available.
+    displayingMenu = true;
+    displayingSession = false;
+    displayingSummary = false;
+    displayingSlider = false;
+    updateGeneratedMenu();
+    displayCurrMenu();
+    if(currMenu->getMenuName() == "Review Session History") {
+        while(snapshot.selectedRow >= historyModel->rowCount() && historyModel->canFetchMore(QModelIndex())) historyModel->fetchMore(QModelIndex());
+    }
+    if(snapshot.selectedRow > 0 && snapshot.selectedRow < currentMenuSize()) setCurrentMenuRow(snapshot.selectedRow);
+
+    if(snapshot.view == DeviceSnapshot::SliderView && currMenu->getMenuName() == "Settings") {
+        this->displayingMenu = false;
+        this->displayingSlider = true;
+        displaySettingView();
+    } else if(snapshot.view == DeviceSnapshot::SummaryView) {
+        this->displayingMenu = false;
+        displaySessionSummary(snapshot.summary);
+        this->summaryHistoryRow = snapshot.summaryHistoryRow;
+    }
+    qInfo("Restored the device snapshot in %lld ms", restoreTime.elapsed());
+}
+
+/*  Purpose: This method is responsible for displaying the summary of a Session that was interrupted by the device losing power, rebuilt
+    from the journal, so that the user can choose to keep it like any other summary.*/
+void MainWindow::recoverJournal() {
+    if(!this->journal->hasRecoverableSession()) return;
+    int profileIndex = -1;
+    Log recovered = this->journal->recover(&profileIndex);
+    this->journal->discard();
+    if(recovered.getSessionLength() <= 0) return;
+
+    if(profileIndex >= 0 && profileIndex < profileManager->getProfileNames().size() && profileIndex != profileManager->getActiveIndex()) {
+        switchProfile(profileIndex);
+    }
+    qInfo("Recovered a %d second Session from the journal", recovered.getSessionLength());
+    this->displayingMenu = false;
+    this->displayingSlider = false;
+    displaySessionSummary(recovered);
+}
+
+/*Purpose: Returns the path of the file the device snapshot is saved in.*/
+QString MainWindow::snapshotPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/snapshot.dat";
+}
+
+/*  Purpose: Formats 'seconds' as "mm:ss" for the LCD and the graph. This is called every tick, so it formats the digits directly instead
+    of going through a QDateTime and a format string.*/
+QString MainWindow::formatTime(int seconds) {
+    seconds = qMax(seconds, 0);
+    QChar digits[5] = {QChar('0' + (seconds / 600) % 6), QChar('0' + (seconds / 60) % 10), QChar(':'),
+                       QChar('0' + (seconds % 60) / 10), QChar('0' + seconds % 10)};
+    return QString(digits, 5);
+}
+
+/*  Purpose: Shows the coherence score of each of the Session's coherence windows below the graph. Windows without a score yet (or an
+    empty 'scores') are shown as "-".*/
+void MainWindow::showWindowScores(const QVector<float>& scores) {
+    QStringList parts;
+    for(int w=0;w<Session::NUM_COHERENCE_WINDOWS;w++) {
+        QString score = (w < scores.size() && scores.at(w) >= 0) ? QString::number(scores.at(w)) : "-";
+        parts << QString("%1s: %2").arg(Session::COHERENCE_WINDOWS[w]).arg(score);
+    }
+    ui->windowScoresLabel->setText("Coherence " + parts.join("   "));
+    this->shownWindowScores = scores;
+}
+
 /*  Purpose: This method is responsible for displaying the Session view where the user can start a Session.*/
 void MainWindow::displaySessionView() {
 
@@ -458,13 +870,19 @@ void MainWindow::displaySessionView() {
         ui->lengthStack->itemAt(i)->widget()->setVisible(true);
         ui->acheivementStack->itemAt(i)->widget()->setVisible(true);
     }
-
-    //Create the scene.
-    QGraphicsView* graph = ui->hrvGraph;
-    graph->setAlignment(Qt::AlignLeft);                 //Ensures the graph starts being drawn on the left side of the screen.
-    this->scene = new QGraphicsScene(graph);
+    ui->windowScoresLabel->setVisible(true);
+    showWindowScores(QVector<float>());
+    ui->hrvMetricsLabel->setVisible(false);             //Only shown on the summary.
+
+    //Clear the scene and stop plotting any summary that was on it.
+    summaryPlotTimer->stop();
+    this->summaryThumbnail = NULL;
+    scene->clear();
+    MemoryStats::release(MemoryStats::GraphScene, this->sceneBytes, this->sceneItems);
+    this->sceneBytes = 0;
+    this->sceneItems = 0;
     scene->setSceneRect(0, 0, 320, 160);                //Stops the scene from moving around.
-    graph->setScene(scene);
+    this->plottedPulses = 0;
 }
 
 /*  Purpose: This method is responsible for beginning a Session, measuring the user's heart rate and using it to compute the
@@ -472,56 +890,76 @@ void MainWindow::displaySessionView() {
 */
 void MainWindow::beginSession(){
     this->sessionActive = true;
+    this->journal->begin(currentSession->getChallengeLevel(), currentSession->getPacerSpeed(), profileManager->getActiveIndex());
     this->currentSession->beginSession();
+    this->breathPacer->setBreathLength(this->currentSession->getPacerSpeed());
+    this->breathPacer->start();
 }
 
 /*  Purpose: This method is responsible for stopping the Session object from receiving pulse data and
- *  creating a new underlying Session object for the device.
+ *  resetting the underlying Session object so it can be used for the next Session.
 */
 void MainWindow::endSession(){
+    this->renderScheduler->cancelFrame();
+    this->breathPacer->stop();
     this->currentSession->endSession();
     ui->coherenceLight->setStyleSheet("");              //Turns off the coherence light.
+
+    //A Session ended by the device turning off is kept in the journal to be recovered, any other Session has ended normally.
+    if(this->powerOn) this->journal->discard();
+    else this->journal->close();
+    this->lightLevel = "NA";
     this->sessionActive = false;
     this->displayingSession = false;
 
-    //Create a new session object to be the underlying Session on the device.
-    this->currentSession=new Session(3, 10);
-    connect(currentSession, &Session::getSensorReading, generator, &Datagen::getSensorReading);
-    connect(generator, &Datagen::sendSensorReading, currentSession, &Session::updatePulseData);
-    connect(currentSession, &Session::updateSessionDisplay, this, &MainWindow::plotPulsePoint);
-    connect(currentSession, &Session::sendSessionSummary, this, &MainWindow::displaySessionSummary);
+    //Reuse the underlying Session for the next Session. Its Settings and connections are kept.
+    this->currentSession->reset();
 }
 
 /*  Purpose: This method is responsible for plotting the pulse data given in the argument 'pulseData' on a QGraphicsScene.
     It is used both to display the pulseData that is obtained during a Session and to display the Log of pulseData when the
-    user is viewing the Session history.
+    user is viewing the Session history. Points before 'firstPoint' are assumed to already be on the scene and points from 'lastPoint'
+    on (every point if it is -1) are left for a later call.
 */
-void MainWindow::plotHRVGraph(QVector<float> pulseData) {
+void MainWindow::plotHRVGraph(QVector<float> pulseData, int firstPoint, int lastPoint) {
     float currentWidth = scene->sceneRect().right();
+    qint64 addedBytes = 0;                              //Estimated size of the items added to the scene, for MemoryStats.
+    int addedItems = 0;
 
-    for(int i=0;i<pulseData.size();i++) {
+    if(lastPoint < 0 || lastPoint > pulseData.size()) lastPoint = pulseData.size();
+    for(int i=firstPoint;i<lastPoint;i++) {
         //Expand the Scene window if the line is near the right end of it.
         if (i*10 > currentWidth - 50) scene->setSceneRect(0, 0, currentWidth + 320, 160);
 
         float pulse = pulseData.at(i);
         scene->addEllipse(i * 10, -4 * pulse + 400, 1, 1, *linePen);
+        addedBytes += sizeof(QGraphicsEllipseItem);
+        addedItems++;
         if(i >=1) {
             float previousPulse = pulseData.at(i-1);
             scene->addLine(i * 10, -4 * pulse + 400,
                                  (i-1) * 10, -4 * previousPulse + 400, *linePen);
+            addedBytes += sizeof(QGraphicsLineItem);
+            addedItems++;
         }
         if (i % 5 == 0) {
             //Display the time.
-            QString time = QDateTime::fromTime_t(i).toUTC().toString("mm:ss");
+            QString time = formatTime(i);
             QGraphicsTextItem* text = scene->addText(time);
             text->setScale(0.8);
             text->setPos((i * 10) - 15, 130);
+            addedBytes += sizeof(QGraphicsTextItem) + time.capacity() * sizeof(QChar);
+            addedItems++;
         }
     }
+
+    MemoryStats::allocate(MemoryStats::GraphScene, addedBytes, addedItems);
+    this->sceneBytes += addedBytes;
+    this->sceneItems += addedItems;
 }
 
 /*  Purpose: The purpose of this method is to display a QSlider on screen that allows the user to change
-    the current 'Challenge Level' or 'Breath Pacer Speed'. When the slider is displayed, the user simply uses
+    the current 'Challenge Level', 'Breath Pacer Speed' or 'Simulation Speed'. When the slider is displayed, the user simply uses
     the left and right arrow buttons to move the slider. They can press the 'Menu' button, the "Back" button or
     the selector button on the UI to return from the slider view.
 */
@@ -538,13 +976,21 @@ void MainWindow::displaySettingView() {
 
     }
     //Displays the slider where the user is able to change the pacer speed.
-    else {
+    else if(ui->menuWidget->currentRow() == 1) {
         ui->menuLabel->setText("Breath Pacer Speed");
         ui->settingValue->setMinimum(1);
         ui->settingValue->setMaximum(30);
         ui->settingValue->setValue(currentSession->getPacerSpeed());
         ui->settingText->setText(QString::number(currentSession->getPacerSpeed()));
     }
+    //Displays the slider where the user is able to change how much faster than real time the device runs.
+    else {
+        ui->menuLabel->setText("Simulation Speed");
+        ui->settingValue->setMinimum(0);
+        ui->settingValue->setMaximum(SimClock::NUM_SPEEDS - 1);
+        ui->settingValue->setValue(SimClock::getSpeedIndex());
+        ui->settingText->setText(SimClock::getSpeedName(SimClock::getSpeed()));
+    }
 }
 
 /*Purpose: This method is responsible for allowing the user to change the value of a Setting when viewing the slider.*/
@@ -560,13 +1006,22 @@ void MainWindow::changeSetting() {
     }
 
     //Handles the case where the user is changing the breath pacer speed
-    else if (this->displayingSlider) {
+    else if (this->displayingSlider && ui->menuWidget->currentRow() == 1) {
         if(this->increaseSetting) currentSession->setPacerSpeed(currentSession->getPacerSpeed() + 1);
         else currentSession->setPacerSpeed(currentSession->getPacerSpeed() - 1);
 
         ui->settingValue->setValue(currentSession->getPacerSpeed());
         ui->settingText->setText(QString::number(currentSession->getPacerSpeed()));
     }
+
+    //Handles the case where the user is changing the simulation speed
+    else if (this->displayingSlider) {
+        int index = SimClock::getSpeedIndex() + (this->increaseSetting ? 1 : -1);
+        SimClock::setSpeed(SimClock::SPEEDS[qBound(0, index, SimClock::NUM_SPEEDS - 1)]);
+
+        ui->settingValue->setValue(SimClock::getSpeedIndex());
+        ui->settingText->setText(SimClock::getSpeedName(SimClock::getSpeed()));
+    }
 }
 
 
@@ -4,11 +4,23 @@
 #include <QMainWindow>
 #include <QListWidget>
 #include <QGraphicsTextItem>
+#include <QGraphicsPixmapItem>
+#include <QTimer>
 #include "log.h"
 #include "menu.h"
 #include "profile.h"
+#include "profilemanager.h"
 #include "session.h"
 #include "datagen.h"
+#include "powermodel.h"
+#include "renderscheduler.h"
+#include "breathpacer.h"
+#include "historylistmodel.h"
+#include "devicesnapshot.h"
+#include "memorystats.h"
+#include "tracer.h"
+#include "streampublisher.h"
+#include "sessionjournal.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -22,6 +34,9 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    void startPublishing();
+    void setSensorSeed(quint32 seed);
+
 private:
     Ui::MainWindow *ui;
 
@@ -29,7 +44,8 @@ private:
     Menu* mainMenu;
     Menu* currMenu;                     //The current Menu we are on or the last Menu seen if not "displayingMenu"
 
-    Profile* profile;                   //The underlying Profile object for the device.
+    ProfileManager* profileManager;     //Keeps track of every user Profile on the device.
+    Profile* profile;                   //The active Profile on the device (owned by 'profileManager').
     Session* currentSession;            //The underlying Session object for the device.
     Datagen* generator;                 //Used to generate basic periodic data.
 
@@ -48,8 +64,28 @@ private:
     //Used for plotting pulse points.
     QPen* linePen;
     QGraphicsScene* scene;
+    qint64 sceneBytes;                                  //Estimated bytes of the items on 'scene', counted in MemoryStats.
+    int sceneItems;                                     //The number of items on 'scene'.
     Log sessionSummary;                                 //Used for saving a Log of a Session.
-    QTimer* batteryTimer;                               //Used for reducing the battery level after every X seconds.
+    int summaryHistoryRow;                              //The position in the Session history of the displayed summary, or -1.
+    HistoryListModel* historyModel;                     //Lists the active Profile's Session history.
+    PowerModel* powerModel;                             //Charges the energy used by the device to the battery.
+
+    //Used for coalescing Session view updates into frames.
+    RenderScheduler* renderScheduler;
+    Log latestLog;                                      //The most recent Log received from the Session.
+    QString lightLevel;                                 //The coherence level the coherence light is currently styled for.
+    QVector<float> shownWindowScores;                   //The window coherence scores currently shown in the Session view.
+    int plottedPulses;                                  //The number of pulse points already plotted on 'scene'.
+    BreathPacer* breathPacer;                           //Times the user's breaths during a Session.
+    StreamPublisher* streamPublisher;                   //Shares every Session tick with other processes, or NULL if not publishing.
+    SessionJournal* journal;                            //Keeps the active Session on disk so it can be recovered after a power loss.
+
+    //Used for showing a summary at once and plotting its full graph over the following event loop turns.
+    static const int SUMMARY_PLOT_CHUNK = 60;           //The number of pulse points plotted per turn.
+    QTimer* summaryPlotTimer;
+    QVector<float> summaryPulses;                       //The pulse data of the displayed summary.
+    QGraphicsPixmapItem* summaryThumbnail;              //The stored thumbnail shown until the full graph is plotted, or NULL.
 
     //Methods used to display the different views and configure the device.
     void initializeMainMenu();
@@ -60,10 +96,28 @@ private:
     void revertSessionView();
     void beginSession();
     void endSession();
-    void plotHRVGraph(QVector<float> pulses);
+    void plotHRVGraph(QVector<float> pulses, int firstPoint = 0, int lastPoint = -1);
     void changeSetting();
+    void switchProfile(int index);
+    void updateStatisticsMenu();
+    void updateFilterMenu();
+    void toggleHistoryFilter(int row);
+    void updateDiagnosticsMenu();
+    void updateGeneratedMenu();
+    int currentMenuRow();
+    int currentMenuSize();
+    void setCurrentMenuRow(int row);
+    void saveSnapshot();
+    void restoreSnapshot();
+    QString snapshotPath();
+    void recoverJournal();
+    static QString formatTime(int seconds);
+    void showWindowScores(const QVector<float>& scores);
 private slots:
     void plotPulsePoint(Log currentLog);
+    void renderSessionFrame();
+    void plotSummaryChunk();
+    void updateBreathPacer(int value, bool inhaling);
     void sensorStateChanged(const QString& text);
     void togglePowerOn();
     void navigateDownMenu();
@@ -74,7 +128,7 @@ private slots:
     void goToMainMenu();
     void goBack();
     void displaySessionSummary(Log summary);
-    void drainBattery();
+    void updateBatteryLevel(int level);
     void rechargeBattery();
 };
 #endif // MAINWINDOW_H
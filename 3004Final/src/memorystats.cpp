@@ -0,0 +1,56 @@
+#include "memorystats.h"
+
+//Every count starts at 0.
+std::atomic<qint64> MemoryStats::bytes[MemoryStats::NUM_SUBSYSTEMS] = {};
+std::atomic<qint64> MemoryStats::objects[MemoryStats::NUM_SUBSYSTEMS] = {};
+std::atomic<qint64> MemoryStats::peakBytes[MemoryStats::NUM_SUBSYSTEMS] = {};
+
+//Setter methods
+
+/*Purpose: Records that 'subsystem' now holds 'bytes' more bytes and 'objects' more objects.*/
+void MemoryStats::allocate(Subsystem subsystem, qint64 bytes, qint64 objects) {
+    qint64 current = MemoryStats::bytes[subsystem].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    MemoryStats::objects[subsystem].fetch_add(objects, std::memory_order_relaxed);
+
+    //Raise the peak if this allocation passed it.
+    qint64 peak = peakBytes[subsystem].load(std::memory_order_relaxed);
+    while(current > peak && !peakBytes[subsystem].compare_exchange_weak(peak, current, std::memory_order_relaxed));
+}
+
+/*Purpose: Records that 'subsystem' released 'bytes' bytes and 'objects' objects.*/
+void MemoryStats::release(Subsystem subsystem, qint64 bytes, qint64 objects) {
+    MemoryStats::bytes[subsystem].fetch_sub(bytes, std::memory_order_relaxed);
+    MemoryStats::objects[subsystem].fetch_sub(objects, std::memory_order_relaxed);
+}
+
+//Getter methods
+qint64 MemoryStats::getBytes(Subsystem subsystem) {return bytes[subsystem].load(std::memory_order_relaxed);}
+qint64 MemoryStats::getObjects(Subsystem subsystem) {return objects[subsystem].load(std::memory_order_relaxed);}
+qint64 MemoryStats::getPeakBytes(Subsystem subsystem) {return peakBytes[subsystem].load(std::memory_order_relaxed);}
+
+QString MemoryStats::getName(Subsystem subsystem) {
+    switch(subsystem) {
+        case SessionBuffers: return "Session buffers";
+        case History: return "History";
+        case GraphScene: return "Graph scene";
+        case Menus: return "Menus";
+        default: return "Unknown";
+    }
+}
+
+/*Purpose: Returns one line per subsystem describing the memory it currently holds and the most it has held.*/
+QStringList MemoryStats::getReport() {
+    QStringList report = QStringList();
+    for(int i=0;i<NUM_SUBSYSTEMS;i++) {
+        Subsystem subsystem = (Subsystem) i;
+        report.append(QString("%1: %2 KB, %3 objects (peak %4 KB)").arg(getName(subsystem))
+                      .arg(getBytes(subsystem) / 1024.0, 0, 'f', 1).arg(getObjects(subsystem))
+                      .arg(getPeakBytes(subsystem) / 1024.0, 0, 'f', 1));
+    }
+    return report;
+}
+
+/*Purpose: Prints the memory report. Called when the application exits.*/
+void MemoryStats::dump() {
+    foreach(QString line, getReport()) qInfo("Memory: %s", qPrintable(line));
+}
@@ -0,0 +1,37 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+/*  The MemoryStats class keeps a running count of the bytes and objects held by each subsystem of the device. The counts are updated by
+    the subsystems at the points where they allocate and release memory, so they can be read at any time without walking any data. The
+    byte counts are estimates of the data each subsystem owns (container capacities and object sizes), not exact heap usage.
+*/
+class MemoryStats {
+
+    public:
+        //The subsystems that memory is accounted to.
+        enum Subsystem {SessionBuffers, History, GraphScene, Menus, NUM_SUBSYSTEMS};
+
+        //Setter methods
+        static void allocate(Subsystem subsystem, qint64 bytes, qint64 objects = 0);
+        static void release(Subsystem subsystem, qint64 bytes, qint64 objects = 0);
+
+        //Getter methods
+        static qint64 getBytes(Subsystem subsystem);
+        static qint64 getObjects(Subsystem subsystem);
+        static qint64 getPeakBytes(Subsystem subsystem);
+        static QString getName(Subsystem subsystem);
+        static QStringList getReport();
+
+        static void dump();
+
+    private:
+        static std::atomic<qint64> bytes[NUM_SUBSYSTEMS];             //Bytes currently held by each subsystem.
+        static std::atomic<qint64> objects[NUM_SUBSYSTEMS];           //Objects currently held by each subsystem.
+        static std::atomic<qint64> peakBytes[NUM_SUBSYSTEMS];         //The most bytes each subsystem has held at once.
+};
+
+#endif // MEMORYSTATS_H
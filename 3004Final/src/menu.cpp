@@ -6,10 +6,14 @@ Menu::Menu(QString name, QStringList list, Menu* prevMenu){
   items = list;
   previousMenu = prevMenu;
   subMenus = QVector<Menu*>();
+  accountedBytes = 0;
+  MemoryStats::allocate(MemoryStats::Menus, 0, 1);
+  updateMemoryAccount();
 }
 
 Menu::~Menu() {
     foreach(Menu* menu, subMenus) delete menu;
+    MemoryStats::release(MemoryStats::Menus, accountedBytes, 1);
 }
 
 //Getter methods
@@ -22,7 +26,15 @@ Menu* Menu::getSubMenuAt(int index) {
 }
 
 //Setter methods
-void Menu::addSubMenu(Menu *menu){subMenus.append(menu);}
-void Menu::addListItem(QString itemName){this->items.append(itemName);}
-void Menu::removeitemAt(int index){this->items.removeAt(index);}
-void Menu::clear() {this->items.clear();}
+void Menu::addSubMenu(Menu *menu){subMenus.append(menu); updateMemoryAccount();}
+void Menu::addListItem(QString itemName){this->items.append(itemName); updateMemoryAccount();}
+void Menu::removeitemAt(int index){this->items.removeAt(index); updateMemoryAccount();}
+void Menu::clear() {this->items.clear(); updateMemoryAccount();}
+
+//Estimates the bytes held by this menu and its items and updates MemoryStats with the change since the last estimate.
+void Menu::updateMemoryAccount() {
+  qint64 bytes = sizeof(Menu) + menuName.capacity() * sizeof(QChar) + subMenus.capacity() * sizeof(Menu*);
+  foreach(const QString& item, items) bytes += sizeof(QString) + item.capacity() * sizeof(QChar);
+  MemoryStats::allocate(MemoryStats::Menus, bytes - accountedBytes);
+  accountedBytes = bytes;
+}
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include "memorystats.h"
 
 /*  The Menu class is responsible for being a node in a tree of Menus that begins at the Main Menu which has 'prevMenu=NULL'.
     Each Menu has a list of items that are displayed in a QListWidget on the device.
@@ -32,7 +33,9 @@ class Menu{
     QStringList items;          // The listed menu iteams on the menu section
     Menu* previousMenu;         // The main menu display of the device
     QVector<Menu*> subMenus;    // The sub menu option that found in a selected menu
-    
+    qint64 accountedBytes;      // The bytes of this menu that are currently counted in MemoryStats
+
+    void updateMemoryAccount();
 };
 
 
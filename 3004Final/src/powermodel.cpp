@@ -0,0 +1,115 @@
+#include "powermodel.h"
+
+//Percentage of the battery used per (simulated) millisecond that the device is on (the old model drained 5% every 30 seconds).
+static const double IDLE_DRAIN = 5.0 / 30000.0;
+
+//Percentage of the battery used by a single occurrence of each PowerModel::Event.
+static const double EVENT_COST[PowerModel::NUM_EVENTS] = {
+    0.005,          //SensorSample
+    0.005,          //Redraw
+    0.02,           //CoherenceComputation
+    0.05            //Beep
+};
+
+//Time constant (in ms) of the moving average used to predict the event drain.
+static const double RATE_TIME_CONSTANT = 60000.0;
+
+//Constructor for the PowerModel class.
+PowerModel::PowerModel(int startingLevel, QObject* parent): QObject(parent) {
+    this->energy = startingLevel;
+    this->displayedLevel = startingLevel;
+    this->running = false;
+    this->eventRate = 0;
+    this->idleSince = 0;
+    for(int i=0;i<NUM_EVENTS;i++) this->eventEnergy[i] = 0;
+
+    this->levelTimer = new QTimer(this);
+    this->levelTimer->setSingleShot(true);
+    connect(levelTimer, &QTimer::timeout, this, &PowerModel::updateLevel);
+    connect(SimClock::instance(), &SimClock::speedChanged, this, &PowerModel::updateTimer);
+}
+
+//Getter methods
+int PowerModel::getBatteryLevel() {return this->displayedLevel;}
+float PowerModel::getEnergyUsed(Event event) {return this->eventEnergy[event];}
+
+/*Purpose: Returns the predicted number of milliseconds until the battery is empty at the current idle and event drain.*/
+qint64 PowerModel::predictTimeToEmpty() {
+    double elapsed = this->running ? SimClock::now() - this->idleSince : 0;
+    double rate = IDLE_DRAIN + this->eventRate * qExp(-elapsed / RATE_TIME_CONSTANT);
+    return (qint64) (qMax(this->energy - IDLE_DRAIN * elapsed, 0.0) / rate);
+}
+
+/***IMPLEMENTING THE SLOTS FOR THE POWERMODEL CLASS***/
+
+/*Purpose: Charges the energy used by one occurrence of 'event' to the battery.*/
+void PowerModel::chargeEvent(PowerModel::Event event) {
+    if(!this->running) return;
+    double elapsed = SimClock::now() - this->idleSince;
+    accountIdle();
+
+    this->energy -= EVENT_COST[event];
+    this->eventEnergy[event] += EVENT_COST[event];
+    this->eventRate = this->eventRate * qExp(-elapsed / RATE_TIME_CONSTANT) + EVENT_COST[event] / RATE_TIME_CONSTANT;
+    updateLevel();
+}
+
+/*Purpose: Sets the remaining energy to 'level' percent. Used to recharge the battery.*/
+void PowerModel::setBatteryLevel(int level) {
+    accountIdle();
+    this->energy = qBound(0, level, 100);
+    updateLevel();
+}
+
+/*Purpose: Called when the device is turned on. Starts the idle drain, or reports an empty battery at once.*/
+void PowerModel::start() {
+    this->running = true;
+    this->idleSince = SimClock::now();
+    updateLevel();
+
+    //An empty battery never changes level again, so report it now for the device to turn itself back off.
+    if(this->energy <= 0) emit batteryLevelChanged(0);
+}
+
+/*Purpose: Called when the device is turned off. Accounts for the idle drain so far and stops draining.*/
+void PowerModel::stop() {
+    accountIdle();
+    this->running = false;
+    this->levelTimer->stop();
+    updateLevel();
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE POWERMODEL CLASS***/
+
+/*Purpose: Removes the idle energy used since the last time this method was called.*/
+void PowerModel::accountIdle() {
+    if(!this->running) return;
+    qint64 now = SimClock::now();
+    this->energy -= IDLE_DRAIN * (now - this->idleSince);
+    this->idleSince = now;
+}
+
+/*  Purpose: Reports the battery level if the displayed level changed and arms 'levelTimer' for the moment the idle drain will next
+    change it.*/
+void PowerModel::updateLevel() {
+    accountIdle();
+    if(this->energy < 0) this->energy = 0;
+    HRV_TRACE_COUNTER("Battery energy (%)", this->energy);
+
+    //The displayed level only reaches 0 once the battery is completely empty.
+    int level = qCeil(this->energy);
+    if(level != this->displayedLevel) {
+        this->displayedLevel = level;
+        emit batteryLevelChanged(level);
+    }
+
+    if(this->running && this->energy > 0) {
+        double untilNextLevel = (this->energy - (this->displayedLevel - 1)) / IDLE_DRAIN;
+        this->levelTimer->start(SimClock::toWallInterval((qint64) qCeil(untilNextLevel) + 1));
+    }
+}
+
+/*Purpose: Re-arms 'levelTimer' for the SimClock's new speed. Called whenever the speed changes.*/
+void PowerModel::updateTimer() {
+    if(this->running) updateLevel();
+}
@@ -0,0 +1,58 @@
+#ifndef POWERMODEL_H
+#define POWERMODEL_H
+
+#include <QObject>
+#include <QTimer>
+#include "simclock.h"
+#include <QtMath>
+#include "tracer.h"
+
+/*  The PowerModel class is responsible for keeping track of the device's battery. Instead of removing a fixed amount on a timer, energy is
+    charged to the events that use it (sensor samples, screen redraws, coherence computations and beeps) on top of a constant idle drain
+    while the device is on. The battery level is only reported when the displayed (whole percent) level actually changes, and a single
+    shot timer is only armed for the moment the idle drain alone would change it. Idle time is measured on the SimClock, so the battery
+    drains faster when the device is accelerated but by the same amount per simulated second.
+*/
+class PowerModel: public QObject {
+
+    Q_OBJECT
+
+    public:
+        //The events that are charged energy.
+        enum Event {SensorSample, Redraw, CoherenceComputation, Beep, NUM_EVENTS};
+
+        //Constructor
+        PowerModel(int startingLevel, QObject* parent=0);
+
+        //Getter methods
+        int getBatteryLevel();
+        float getEnergyUsed(Event event);
+        qint64 predictTimeToEmpty();
+
+    signals:
+        void batteryLevelChanged(int level);            //Emitted whenever the displayed battery level changes.
+
+    public slots:
+        void chargeEvent(PowerModel::Event event);
+        void setBatteryLevel(int level);
+        void start();
+        void stop();
+
+    private slots:
+        void updateTimer();
+
+    private:
+        double energy;                                  //The remaining energy, as a percentage of a full battery.
+        int displayedLevel;                             //The last battery level that was reported.
+        bool running;                                   //Whether or not the device is on (and draining idle power).
+        qint64 idleSince;                               //The SimClock time idle power was last accounted for.
+        QTimer* levelTimer;                             //Fires when the idle drain alone would change the displayed level.
+        double eventRate;                               //Exponentially decaying average of the event drain (percent per ms).
+        double eventEnergy[NUM_EVENTS];                 //Total energy charged to each event since the model was created.
+
+        //Helper methods
+        void accountIdle();
+        void updateLevel();
+};
+
+#endif // POWERMODEL_H
@@ -1,14 +1,33 @@
 #include "profile.h"
 
 //Constructor
-Profile::Profile(int startingBattery) {
+Profile::Profile(QString name, QString storageDirectory, int startingBattery): sessionHistory(storageDirectory) {
+    this->name = name;
     this->batteryLevel = startingBattery;
-    this->sessionHistory = QVector<Log>();
+
+    //Build the statistics and the indexes for the Sessions that were already stored.
+    const QVector<HistoryEntry>& entries = this->sessionHistory.getIndex();
+    for(int i=0;i<entries.size();i++) this->analytics.addSession(entries.at(i));
+    this->historyIndex.build(entries);
 }
 
 //Getter methods
+QString Profile::getName() {return this->name;}
 int Profile::getBatteryLevel() {return this->batteryLevel;}
-QVector<Log> Profile::getSessionHistory() {return this->sessionHistory;}
+int Profile::getSessionCount() {return this->sessionHistory.count();}
+Log Profile::getSessionAt(int index) {return this->sessionHistory.getSessionAt(index);}
+
+//Returns the summaries of every stored Session, in the order they were stored.
+const QVector<HistoryEntry>& Profile::getSessionIndex() {return this->sessionHistory.getIndex();}
+
+const HistoryAnalytics& Profile::getAnalytics() {return this->analytics;}
+QString Profile::getThumbnailPath(const QDateTime& date) {return this->sessionHistory.getThumbnailPath(date);}
+
+//Returns the positions of the stored Sessions matching 'query', in the order they were stored.
+QVector<int> Profile::querySessions(const HistoryQuery& query) {return this->historyIndex.query(query, this->sessionHistory.getIndex());}
+
+//Returns the position of the stored Session recorded at 'date', or -1 if there is none.
+int Profile::findSession(const QDateTime& date) {return this->historyIndex.find(date);}
 
 //Setter methods
 
@@ -20,22 +39,26 @@ void Profile::setBatteryLevel(int level){
     this->batteryLevel = level;
 }
 
-//Used to add a new Session to the history of Sessions QVector
+//Used to add a new Session to the history of Sessions. Ensures a given Session is not added again if we press "Keep Summary" when
+//viewing it after already adding it.
 int Profile::addNewSession(Log session){
-    for(int i =0;i<this->sessionHistory.size();i++){
-        //Ensures a given Session is not added again if we press "Keep Summary" when viewing it after already adding it.
-        if(this->sessionHistory.at(i).getDateTime() == session.getDateTime()) return -1;
-    }
-    this->sessionHistory.append(session);
+    if(this->sessionHistory.append(session) != 0) return -1;
+    this->analytics.addSession(this->sessionHistory.getIndex().last());
+    this->historyIndex.addSession(this->sessionHistory.getIndex().last(), this->sessionHistory.count() - 1);
     return 0;
 }
 
-//Used to remove a Session from the history of Sessions QVector.
+//Used to remove a Session from the history of Sessions.
 int Profile::removeSession(int index){
-    if(index < this->sessionHistory.size()){
-        this->sessionHistory.removeAt(index);
-        return 0;
-    }
-    return -1;
+    if(index < 0 || index >= this->sessionHistory.count()) return -1;
+    HistoryEntry entry = this->sessionHistory.getIndex().at(index);
+    if(this->sessionHistory.removeAt(index) != 0) return -1;
+    this->analytics.removeSession(entry);
+    this->historyIndex.removeSession(index);
+    return 0;
+}
+void Profile::resetDevice() {
+    this->sessionHistory.clear();
+    this->analytics.clear();
+    this->historyIndex.clear();
 }
-void Profile::resetDevice() {this->sessionHistory = QVector<Log>();}
@@ -1,18 +1,29 @@
 #ifndef PROFILE_H
 #define PROFILE_H
 #include "log.h"
+#include "historystore.h"
+#include "historyanalytics.h"
+#include "historyindex.h"
+#include <QStringList>
 
 /*The purpose of this class is to store the Session history and Battery level. It provides methods to access and modify these values
- as well.*/
+ as well. Each Profile belongs to one user and keeps its Session history in its own HistoryStore.*/
 class Profile{
   
   public:
     //Constructor
-    Profile(int startingBattery);
+    Profile(QString name, QString storageDirectory, int startingBattery);
 
     //Getters
+    QString getName();
     int getBatteryLevel();
-    QVector<Log> getSessionHistory();
+    int getSessionCount();
+    Log getSessionAt(int index);
+    const QVector<HistoryEntry>& getSessionIndex();
+    const HistoryAnalytics& getAnalytics();
+    QString getThumbnailPath(const QDateTime& date);
+    QVector<int> querySessions(const HistoryQuery& query);
+    int findSession(const QDateTime& date);
 
     //Setters
     void setBatteryLevel(int level);
@@ -22,8 +33,11 @@ class Profile{
   
   private:
     //NOTE: All values here must be stored persistently.
+    QString name;                               //The name of the user the Profile belongs to.
     int batteryLevel;                           //Keeps track of the battery level, which is an int in interval [1, 100]
-    QVector<Log> sessionHistory;                //History of all Sessions on the device.
+    HistoryStore sessionHistory;                //History of all of this Profile's Sessions.
+    HistoryAnalytics analytics;                 //Statistics over 'sessionHistory', kept up to date as Sessions are added and removed.
+    HistoryIndex historyIndex;                  //Sorted indexes over 'sessionHistory' used to answer queries.
 };
 
 
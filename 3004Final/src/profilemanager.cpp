@@ -0,0 +1,80 @@
+#include "profilemanager.h"
+
+//Constructor for the ProfileManager class.
+ProfileManager::ProfileManager(int startingBattery) {
+    this->storageDirectory = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/profiles");
+    this->storageDirectory.mkpath(".");
+    loadProfileList();
+
+    //Every device starts with at least one Profile.
+    if(this->profileNames.isEmpty()) {
+        this->profileNames.append("User 1");
+        this->activeIndex = 0;
+        saveProfileList();
+    }
+    this->activeProfile = new Profile(this->profileNames.at(this->activeIndex), profileDirectory(this->activeIndex), startingBattery);
+}
+
+//Destructor for the ProfileManager class.
+ProfileManager::~ProfileManager() {
+    delete activeProfile;
+}
+
+//Getter methods
+Profile* ProfileManager::getActiveProfile() {return this->activeProfile;}
+int ProfileManager::getActiveIndex() {return this->activeIndex;}
+QStringList ProfileManager::getProfileNames() {return this->profileNames;}
+QString ProfileManager::getProfileDirectory(int index) {return profileDirectory(index);}
+
+//Setter methods
+
+/*  Purpose: Makes the Profile at position 'index' the active Profile. The previous Profile is released and only the new Profile's history
+    index is loaded. The battery level belongs to the device, so it is carried over. Returns the new active Profile.*/
+Profile* ProfileManager::switchProfile(int index) {
+    if(index < 0 || index >= this->profileNames.size() || index == this->activeIndex) return this->activeProfile;
+
+    int batteryLevel = this->activeProfile->getBatteryLevel();
+    delete this->activeProfile;
+    this->activeIndex = index;
+    this->activeProfile = new Profile(this->profileNames.at(index), profileDirectory(index), batteryLevel);
+    saveProfileList();
+    return this->activeProfile;
+}
+
+/*Purpose: Adds a new Profile named 'name' to the device and returns its position. The new Profile is not made active.*/
+int ProfileManager::addProfile(QString name) {
+    this->profileNames.append(name);
+    saveProfileList();
+    return this->profileNames.size() - 1;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE PROFILEMANAGER CLASS***/
+
+QString ProfileManager::profileDirectory(int index) {
+    return this->storageDirectory.filePath(QString("profile_%1").arg(index));
+}
+
+/*Purpose: Reads the list of Profile names and the active Profile from the device's storage directory.*/
+void ProfileManager::loadProfileList() {
+    this->profileNames.clear();
+    this->activeIndex = 0;
+
+    QFile file(this->storageDirectory.filePath("profiles.dat"));
+    if(!file.open(QIODevice::ReadOnly)) return;
+    QDataStream in(&file);
+    qint32 activeIndex;
+    in >> this->profileNames >> activeIndex;
+    if(in.status() != QDataStream::Ok) this->profileNames.clear();
+    else if(activeIndex >= 0 && activeIndex < this->profileNames.size()) this->activeIndex = activeIndex;
+}
+
+/*Purpose: Writes the list of Profile names and the active Profile to the device's storage directory.*/
+void ProfileManager::saveProfileList() {
+    QFile file(this->storageDirectory.filePath("profiles.dat"));
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("Unable to write the Profile list to %s", qPrintable(file.fileName()));
+        return;
+    }
+    QDataStream out(&file);
+    out << this->profileNames << (qint32) this->activeIndex;
+}
@@ -0,0 +1,43 @@
+#ifndef PROFILEMANAGER_H
+#define PROFILEMANAGER_H
+
+#include <QString>
+#include <QStringList>
+#include <QDir>
+#include <QStandardPaths>
+#include "profile.h"
+
+/*  The ProfileManager class is responsible for keeping track of every user Profile on the device. Only the names of the Profiles are kept
+    in memory along with the active Profile, which is the only Profile whose Session history index is loaded. Each Profile's history is
+    stored in its own directory under the device's storage directory.
+*/
+class ProfileManager {
+
+    public:
+        //Constructor and destructor
+        ProfileManager(int startingBattery);
+        ~ProfileManager();
+
+        //Getter methods
+        Profile* getActiveProfile();
+        int getActiveIndex();
+        QStringList getProfileNames();
+        QString getProfileDirectory(int index);
+
+        //Setter methods
+        Profile* switchProfile(int index);
+        int addProfile(QString name);
+
+    private:
+        QDir storageDirectory;                          //The directory holding every Profile's history store.
+        QStringList profileNames;                       //The names of every Profile on the device.
+        int activeIndex;                                //The position of the active Profile in 'profileNames'.
+        Profile* activeProfile;                         //The active Profile.
+
+        //Helper methods
+        QString profileDirectory(int index);
+        void loadProfileList();
+        void saveProfileList();
+};
+
+#endif // PROFILEMANAGER_H
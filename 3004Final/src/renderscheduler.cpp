@@ -0,0 +1,36 @@
+#include "renderscheduler.h"
+
+//Constructor for the RenderScheduler class.
+RenderScheduler::RenderScheduler(int maxFps, QObject* parent): QObject(parent) {
+    this->maxFps = qMax(maxFps, 1);
+    this->frameTimer = new QTimer(this);
+    this->frameTimer->setSingleShot(true);
+    connect(frameTimer, &QTimer::timeout, this, &RenderScheduler::emitFrame);
+}
+
+//Getter methods
+int RenderScheduler::getMaxFps() {return this->maxFps;}
+
+//Setter methods
+void RenderScheduler::setMaxFps(int fps) {this->maxFps = qMax(fps, 1);}
+
+/*  Purpose: Requests that a frame be rendered. If a frame is already pending, the request is merged into it. Otherwise the frame is
+    scheduled for as soon as a full frame interval has passed since the last frame.*/
+void RenderScheduler::requestFrame() {
+    HRV_TRACE_INSTANT("Frame requested");
+    if(this->frameTimer->isActive()) return;
+
+    int frameInterval = 1000 / this->maxFps;
+    qint64 sinceLastFrame = this->lastFrame.isValid() ? this->lastFrame.elapsed() : frameInterval;
+    this->frameTimer->start((int) qMax((qint64) 0, frameInterval - sinceLastFrame));
+}
+
+/*Purpose: Drops a pending frame. Used when the view the frame was requested for is no longer displayed.*/
+void RenderScheduler::cancelFrame() {
+    this->frameTimer->stop();
+}
+
+void RenderScheduler::emitFrame() {
+    this->lastFrame.start();
+    emit renderFrame();
+}
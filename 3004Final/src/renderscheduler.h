@@ -0,0 +1,44 @@
+#ifndef RENDERSCHEDULER_H
+#define RENDERSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "tracer.h"
+
+/*  The RenderScheduler class is responsible for limiting how often the Session view is repainted. Any number of frame requests made
+    between two frames are coalesced into a single 'renderFrame' signal, and frames are never emitted more often than the FPS cap.
+*/
+class RenderScheduler: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static const int DEFAULT_MAX_FPS = 30;
+
+        //Constructor
+        RenderScheduler(int maxFps = DEFAULT_MAX_FPS, QObject* parent=0);
+
+        //Getter methods
+        int getMaxFps();
+
+        //Setter methods
+        void setMaxFps(int fps);
+
+    signals:
+        void renderFrame();                             //Emitted at most once per frame when a frame was requested.
+
+    public slots:
+        void requestFrame();
+        void cancelFrame();
+
+    private:
+        int maxFps;                                     //The maximum number of frames rendered per second.
+        QTimer* frameTimer;                             //Fires when the next requested frame is due.
+        QElapsedTimer lastFrame;                        //Time since the last frame was rendered.
+
+    private slots:
+        void emitFrame();
+};
+
+#endif // RENDERSCHEDULER_H
@@ -3,18 +3,27 @@
 //Intiialize CHALLENGE_THRESHOLDS as an empty QMap.
 QMap<int, QMap<QString, float>> Session::CHALLENGE_THRESHOLDS = QMap<int, QMap<QString, float>>();
 
+//Sessions tick once per second in real time by default.
+int Session::tickInterval = 1000;
+
+//Short-term, standard and long-term coherence windows (in seconds).
+const int Session::COHERENCE_WINDOWS[Session::NUM_COHERENCE_WINDOWS] = {16, 64, 128, 300};
+
 //Constructor for the Session class.
 Session::Session(int challengeLevel, int breathPacerSpeed, QObject *parent):QObject(parent) {
     //Instantiate necessary variables.
     this->challengeLevel = challengeLevel;
     this->breathPacerSpeed = breathPacerSpeed;
     pulseData = QVector<float>();
-    coherenceScore = 0;
-    sessionLength = -1;                                     //Start it at -1 to update the session data at timestep 0
+    crossingCounts = QVector<int>();
+    windowScores = QVector<float>(NUM_COHERENCE_WINDOWS, -1);              //-1 until a score is computed.
+    windowScoreSums = QVector<float>(NUM_COHERENCE_WINDOWS, 0);
     sessionTimer = new QTimer(this);
-    achievementScore = 0;
-    coherenceLevel = "NA";
-    this->levelChanged = false;
+    sessionTimer->setTimerType(Qt::PreciseTimer);
+    startTime = 0;
+    coherenceEngine = CoherenceEngine::create();
+    accountedBytes = 0;
+    MemoryStats::allocate(MemoryStats::SessionBuffers, 0, 1);
 
     //The keys in the QMap are "Low", "Medium" and "High".
     coherenceTimes = QMap<QString, int>();
@@ -22,19 +31,25 @@ Session::Session(int challengeLevel, int breathPacerSpeed, QObject *parent):QObj
     coherenceTimes.insert("Medium", 0);
     coherenceTimes.insert("High", 0);
 
+    //Start with no recorded data.
+    reset();
+
     //Initialize the CHALLENGE_THRESHOLDS QMap if it has not already been done.
     if (CHALLENGE_THRESHOLDS.isEmpty()) {
         initializeThresholds();
     }
 
-    //Connect the QTimer's "timeout" signal to the Session's "updateSessionData" slot.
-    connect(sessionTimer, &QTimer::timeout, this, &Session::updateSessionData);
+    //The QTimer wakes the Session up to run the ticks that are due by the SimClock.
+    connect(sessionTimer, &QTimer::timeout, this, &Session::catchUp);
+    connect(SimClock::instance(), &SimClock::speedChanged, this, &Session::updateTimerInterval);
 
 }
 
 //Destructor for the Session class.
 Session::~Session() {
     delete sessionTimer;
+    delete coherenceEngine;
+    MemoryStats::release(MemoryStats::SessionBuffers, accountedBytes, 1);
 }
 
 
@@ -43,12 +58,14 @@ Session::~Session() {
 /* Purpose: This slot is called in response to the selector button emitting a "pressed" signal when the user is on the session view and the
  * session has not yet begun.*/
 void Session::beginSession() {
+    this->startTime = SimClock::now();
     updateSessionData();
-    sessionTimer->start(1000);
+    sessionTimer->start(SimClock::toWallInterval(tickInterval));
 }
 
-/*Purpose: This slot is called in response to the 'sessionTimer' emitting a 'timeout' signal, which it does every second.*/
+/*Purpose: This slot is called once per tick of the Session, which is once per simulated second unless the device is accelerated.*/
 void Session::updateSessionData() {
+    HRV_TRACE_SCOPE("Session tick");
     this->sessionLength += 1;
     emit getSensorReading(this->sessionLength);
 
@@ -66,14 +83,23 @@ void Session::updateSessionData() {
     currentLog.setAchievementScore(this->achievementScore);
     currentLog.setPulseData(this->pulseData);
     currentLog.setPacerSpeed(this->breathPacerSpeed);
+    currentLog.setRejectedSamples(artifactFilter.getRejectedCount());
+    currentLog.setWindowScores(this->windowScores);
+    currentLog.setHrvMetrics(this->hrvMetrics);
     emit updateSessionDisplay(currentLog);
     this->levelChanged = false;                 //Ensures the device does not keep beeping in between calculating coherence scores
 }
 
-/*  Purpose: This slot is called in response to a Datagen object emitting a sendSensorReading signal. It adds a new reading to the 'pulseData'
- *  QVector.*/
+/*  Purpose: This slot is called in response to a Datagen object emitting a sendSensorReading signal. It passes the reading through the
+ *  artifact filter and adds the cleaned reading to the 'pulseData' QVector.*/
 void Session::updatePulseData(float reading) {
-    pulseData.append(reading);
+    pulseData.append(artifactFilter.filter(reading));
+    hrvMetrics.addReading(pulseData.last());
+
+    //Keep a running count of the readings equal to the (integer) baseline so any window's crossings are counted in constant time.
+    if(pulseData.size() == 1) crossingCounts.append(0);
+    else crossingCounts.append(crossingCounts.last() + (pulseData.last() == (int) pulseData.at(0) ? 1 : 0));
+    updateMemoryAccount();
 }
 
 /* Purpose: Ends the Session when the selector button emits another "pressed" signal after the Session has already started. */
@@ -87,44 +113,78 @@ void Session::endSession() {
     summaryLog.setSessionLength(this->sessionLength);
     summaryLog.setAchievementScore(this->achievementScore);
     summaryLog.setPulseData(this->pulseData);
+    summaryLog.setRejectedSamples(artifactFilter.getRejectedCount());
+    summaryLog.setHrvMetrics(this->hrvMetrics);
+
+    //The summary records the average score of each window over the Session.
+    QVector<float> averageScores = QVector<float>(NUM_COHERENCE_WINDOWS, 0);
+    int scoreCount = this->sessionLength / 5;
+    for(int w=0;w<NUM_COHERENCE_WINDOWS && scoreCount > 0;w++) averageScores[w] = this->windowScoreSums.at(w) / scoreCount;
+    summaryLog.setWindowScores(averageScores);
     emit sendSessionSummary(summaryLog);
 }
 
-/***IMPLEMENTING THE HELPER METHODS FOR THE SESSION CLASS***/
-
-/*  Purpose: Every 5 seconds, this method updates the user's current coherence score, current achievement score and computes whether the
- *  current coherence score is considered "Low", "Medium" or "High", updating the 'coherenceTimes' QMap accordingly. The coherence scoring
- *  algorithm monitors only the most current 64 seconds of heart rhythm data.
-*/
-void Session::updateCoherence() {
+/*  Purpose: Discards all of the data recorded during the last Session so the Session object can be reused for a new Session. The
+ *  Settings, the timer, the signal connections and the capacity of the buffers are kept, so a new Session does not grow its buffers again.*/
+void Session::reset() {
+    sessionTimer->stop();
 
-    //Compute the period of motion of the last 64 seconds of heart rhythm data.
-    int baselineValue = pulseData.at(0);                                        //The starting (baseline) value.
-    int numCrosses = 0;                                                         //The number of times the wave crossed the midline.
-    int dataSum = 0;                                                            //The sum of the data in the 64 second window.
+    //The summary Log of the last Session still shares 'pulseData', so resizing it in place would first copy every reading of that Session.
+    //Releasing the shared buffer and reserving one of the same capacity costs a single allocation and no copy.
+    int pulseCapacity = pulseData.capacity();
+    pulseData = QVector<float>();
+    pulseData.reserve(pulseCapacity);
 
-    //Determine where to start iterating from to compute the coherence score.
-    int i;
-    if(sessionLength < 64) i = 1;
-    else i = sessionLength - 64 + 1;
+    crossingCounts.resize(0);
+    windowScores.fill(-1);
+    windowScoreSums.fill(0);
+    hrvMetrics.reset();
+    coherenceScore = 0;
+    sessionLength = -1;                                     //Start it at -1 to update the session data at timestep 0
+    achievementScore = 0;
+    coherenceLevel = "NA";
+    this->levelChanged = false;
+    for(QMap<QString, int>::iterator time = coherenceTimes.begin(); time != coherenceTimes.end(); ++time) time.value() = 0;
+    artifactFilter.reset();
+    arena.release();
+    updateMemoryAccount();
+}
 
-    QVector<float> recentData = QVector<float>();                               //Used to compute the normalized error.
+/*  Purpose: This slot is called whenever the 'sessionTimer' emits a 'timeout' signal. It runs every tick that is due by the SimClock, so
+    the Session stays in step with simulated time even when the timer fires late or the clock is faster than the timer.*/
+void Session::catchUp() {
+    qint64 dueTicks = (SimClock::now() - this->startTime) / tickInterval;
+    for(int i=0;i<MAX_TICKS_PER_WAKEUP && this->sessionLength < dueTicks;i++) updateSessionData();
+}
 
-    //Compute the number of times the pulse value is equal to the baselineValue.
-    for (;i<=sessionLength;i++) {
-        if(pulseData.at(i) == baselineValue) numCrosses++;
-        dataSum += pulseData.at(i);
-        recentData.append(pulseData.at(i));
-    }
+/*Purpose: This slot is called whenever the SimClock's speed changes. It wakes a running Session up once per tick at the new speed.*/
+void Session::updateTimerInterval() {
+    if(sessionTimer->isActive()) sessionTimer->setInterval(SimClock::toWallInterval(tickInterval));
+}
 
-    //Calculate the period (cycles per minute).
-    float period;
-    if (sessionLength < 64) period = ((float) numCrosses / 2.0) / ((float) sessionLength / 60.0);
-    else period = ((float) numCrosses / 2.0) / ((float) 64.0 / 60.0);
+/***IMPLEMENTING THE HELPER METHODS FOR THE SESSION CLASS***/
 
-    //Calculate the coherence score.
-    float error = computeNormalizedError(recentData, period, baselineValue);
-    coherenceScore = qCeil((1.0 - error) * 16.0);
+/*  Purpose: Every 5 seconds, this method updates the user's current coherence score, current achievement score and computes whether the
+ *  current coherence score is considered "Low", "Medium" or "High", updating the 'coherenceTimes' QMap accordingly. A score is computed
+ *  for each window in COHERENCE_WINDOWS from the same pulse data. The 64 second window is the current coherence score.
+*/
+void Session::updateCoherence() {
+    HRV_TRACE_SCOPE("Coherence computation");
+
+    //Every window is scored from the same readings and running crossing counts by the build's engine.
+    CoherenceInput input;
+    input.readings = pulseData.constData();
+    input.crossingCounts = crossingCounts.constData();
+    input.sessionLength = sessionLength;
+    float scores[NUM_COHERENCE_WINDOWS];
+    coherenceEngine->computeScores(input, COHERENCE_WINDOWS, NUM_COHERENCE_WINDOWS, scores, arena);
+
+    for(int w=0;w<NUM_COHERENCE_WINDOWS;w++) {
+        windowScores[w] = scores[w];
+        windowScoreSums[w] += scores[w];
+    }
+    coherenceScore = windowScores.at(PRIMARY_WINDOW);
+    updateMemoryAccount();
 
     //Update the achievement score.
     achievementScore += coherenceScore;
@@ -132,12 +192,15 @@ void Session::updateCoherence() {
     QString newLevel;                                                       //The newly computed coherence level.
 
     //Determine the current coherence level.
-    if (coherenceScore < CHALLENGE_THRESHOLDS[this->challengeLevel]["Low"]) newLevel = "Low";
-    else if (coherenceScore > CHALLENGE_THRESHOLDS[this->challengeLevel]["High"]) newLevel = "High";
+    //Read-only lookups, so that Sessions running on several threads never modify the shared table.
+    const QMap<QString, float> thresholds = CHALLENGE_THRESHOLDS.value(this->challengeLevel);
+    if (coherenceScore < thresholds.value("Low")) newLevel = "Low";
+    else if (coherenceScore > thresholds.value("High")) newLevel = "High";
     else newLevel = "Medium";
 
     if(this->coherenceLevel.compare(newLevel) != 0) this->levelChanged = true;
     else this->levelChanged= false;
+    if(this->levelChanged) HRV_TRACE_INSTANT("Level change");
 
     this->coherenceLevel = newLevel;
 
@@ -145,37 +208,6 @@ void Session::updateCoherence() {
     coherenceTimes[this->coherenceLevel] += 5;
 }
 
-/*  Purpose: This method is responsible for computing a normalized error value between the pulse data in 'data' and a perfect sine
- *  wave with period 'period' and vertical shift 'vShift'. It uses Mean Squared Error to do so.*/
-float Session::computeNormalizedError(QVector<float> data, float period, float vShift) {
-
-    //We will compute the average error, minimum error and maximum error.
-    float minError = std::numeric_limits<float>::max();
-    float maxError = 0;
-    float averageError = 0;
-
-    //Compute the MSE between each data point and the corresponding point on a perfect sine function with the given 'period' and 'vShift'.
-    for(int i=0;i<data.size();i++) {
-
-        //The time at which the data point was observed.
-        int seconds = sessionLength - data.size() + 1 + i;
-        float currentError = (float) qPow((data.at(i) - (qSin(2.0 * (float) M_PI * period * (seconds / 60.0)) + vShift)), 2.0);
-        if(currentError < minError) minError = currentError;
-        if (currentError > maxError) maxError = currentError;
-        currentError = currentError / data.size();
-        averageError += currentError;
-    }
-
-    //Normalize the error.
-    averageError = (float) (averageError - minError) / (float) (maxError - minError);
-
-    //Increase the error if the period is not in the range of 3-15 cycles per minute.
-    if (period < 3) averageError = qPow(averageError, (1.0 / ((float)(3 - period) * 8.0)));
-    else if (period > 15) averageError = qPow(averageError, (1.0 / ((float) (period - 15) * 8.0)));
-
-    return averageError;
-}
-
 /*  Purpose: This function is responsible for creating a QMap to store all of the threshold values separating "Low", "Medium" and "High"
     coherence at all 4 challenge levels.*/
 void Session::initializeThresholds() {
@@ -199,12 +231,23 @@ void Session::initializeThresholds() {
 //Getter methods
 int Session::getChallengeLevel(){return challengeLevel;}
 int Session::getPacerSpeed(){return breathPacerSpeed;}
+int Session::getTickInterval(){return tickInterval;}
 
 //Setter methods
 void Session::setChallengeLevel(int level){this->challengeLevel = level;}
 void Session::setPacerSpeed(int speed){this->breathPacerSpeed = speed;}
+void Session::setTickInterval(int interval){tickInterval = qMax(interval, 1);}
 
+/*Purpose: Scores coherence with 'engine' from the next update on instead of the build's engine. The Session takes ownership of 'engine'.*/
+void Session::setCoherenceEngine(CoherenceEngine* engine) {
+    delete this->coherenceEngine;
+    this->coherenceEngine = engine;
+}
 
-
-
-
+/*Purpose: Updates MemoryStats if the capacity of the Session's buffers changed since the last update.*/
+void Session::updateMemoryAccount() {
+    qint64 bytes = sizeof(Session) + pulseData.capacity() * sizeof(float) + crossingCounts.capacity() * sizeof(int) + arena.getCapacity();
+    if(bytes == accountedBytes) return;
+    MemoryStats::allocate(MemoryStats::SessionBuffers, bytes - accountedBytes);
+    accountedBytes = bytes;
+}
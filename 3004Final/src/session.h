@@ -9,6 +9,12 @@
 #include <QtMath>
 #include <limits>
 #include "log.h"
+#include "artifactfilter.h"
+#include "memorystats.h"
+#include "sessionarena.h"
+#include "coherenceengine.h"
+#include "tracer.h"
+#include "simclock.h"
 
 /*  This class is responsible for handling the functionality involved in the user being in a Session. This includes getting pulse data
     from the user (with Datagen) and computing the coherence score and other coherence related statistics. In addition, this class
@@ -26,6 +32,20 @@ class Session: public QObject {
         */
         static QMap<int, QMap<QString, float>> CHALLENGE_THRESHOLDS;
 
+        //The lengths (in seconds) of the windows coherence is scored over. The 64 second window decides the level and achievement score.
+        static const int NUM_COHERENCE_WINDOWS = 4;
+        static const int COHERENCE_WINDOWS[NUM_COHERENCE_WINDOWS];
+        static const int PRIMARY_WINDOW = 1;
+
+        //The simulated time (in ms) between two Session ticks. Each tick is one second of Session time, so lowering it speeds the Session
+        //up. The SimClock's speed speeds up every Session without changing the interval.
+        static const int MAX_TICKS_PER_WAKEUP = 100;            //The most overdue ticks run at once, so the GUI stays responsive.
+        static int getTickInterval();
+        static void setTickInterval(int interval);
+
+        //Fills CHALLENGE_THRESHOLDS. Must be called on the main thread before Sessions are used on other threads.
+        static void initializeThresholds();
+
         //Constructor and Destructor.
         Session(int challengeLevel=1, int breathPacerSpeed = 10, QObject* parent=0);
         ~Session();
@@ -37,6 +57,7 @@ class Session: public QObject {
         //Setter methods
         void setChallengeLevel(int level);
         void setPacerSpeed(int speed);
+        void setCoherenceEngine(CoherenceEngine* engine);
 
     signals:
         void updateSessionDisplay(Log currentLog);
@@ -47,7 +68,11 @@ class Session: public QObject {
         void updatePulseData(float reading);
         void beginSession();
         void endSession();
+        void reset();
     private:
+        static int tickInterval;                                //Shared by every Session, 1000 ms unless the device is accelerated.
+        qint64 startTime;                                       //The SimClock time the Session began at.
+
         //SETTINGS RELATED
         int challengeLevel;                                     //A value between 1 and 4 that determines the thresholds between "Low",
                                                                 //"Medium" and "High" coherence.
@@ -55,19 +80,30 @@ class Session: public QObject {
         int breathPacerSpeed;                                   //A value between 1 and 30 indicating the time interval between each breath
 
         //METRICS RELATED
-        QVector<float> pulseData;                               //Keeps track of the most recent 64 seconds of pulse data.
+        QVector<float> pulseData;                               //Keeps track of the pulse data of the Session.
+        QVector<int> crossingCounts;                            //crossingCounts[i] is the number of readings 1 to i equal to the baseline.
         float coherenceScore;                                   //The most recently computed coherence score
+        QVector<float> windowScores;                            //The most recent coherence score of each window in COHERENCE_WINDOWS.
+        QVector<float> windowScoreSums;                         //The sum of the coherence scores of each window, for the summary.
+        HrvMetrics hrvMetrics;                                  //Time-domain HRV metrics, updated with every reading.
+        CoherenceEngine* coherenceEngine;                       //Computes the coherence scores (the build's engine unless replaced).
         int sessionLength;                                      //How long the session has been active for, in seconds.
         QTimer* sessionTimer;                                   //Used to keep track of time.
         float achievementScore;                                 //The current achievement score.
         QString coherenceLevel;                                 //One of "Low", "Medium", "High" or "NA" before the first coherence score is calculated.
         bool levelChanged;                                      //Whether or not a new coherence level was reached.
         QMap<QString, int> coherenceTimes;                      //Keeps track of the time spent in "Low", "Medium" and "High" coherence.
+        ArtifactFilter artifactFilter;                          //Rejects outlier sensor readings before they reach 'pulseData'.
+        SessionArena arena;                                     //Backs the transient working data of the current Session.
+        qint64 accountedBytes;                                  //The bytes of this Session currently counted in MemoryStats.
 
         //Private helper methods for the Session class.
         void updateCoherence();
-        float computeNormalizedError(QVector<float> data, float period, float vShift);
-        void initializeThresholds();
+        void updateMemoryAccount();
+
+    private slots:
+        void catchUp();
+        void updateTimerInterval();
 
 };
 
@@ -0,0 +1,77 @@
+#include "sessionarena.h"
+
+//Constructor for the SessionArena class. No memory is allocated until the first allocation.
+SessionArena::SessionArena() {
+    this->currentBlock = 0;
+    this->offset = 0;
+    this->allocationCount = 0;
+}
+
+//Destructor for the SessionArena class.
+SessionArena::~SessionArena() {
+    for(int i=0;i<this->blocks.size();i++) std::free(this->blocks[i].data);
+}
+
+//Getter methods
+int SessionArena::getAllocationCount() {return this->allocationCount;}
+
+qint64 SessionArena::getCapacity() {
+    qint64 capacity = 0;
+    for(int i=0;i<this->blocks.size();i++) capacity += this->blocks.at(i).size;
+    return capacity;
+}
+
+qint64 SessionArena::getBytesUsed() {
+    qint64 used = this->offset;
+    for(int i=0;i<this->currentBlock && i<this->blocks.size();i++) used += this->blocks.at(i).size;
+    return used;
+}
+
+SessionArena::Mark SessionArena::getMark() {
+    Mark mark;
+    mark.block = this->currentBlock;
+    mark.offset = this->offset;
+    return mark;
+}
+
+//Setter methods
+
+/*  Purpose: Returns 'bytes' bytes of uninitialized memory aligned to 'alignment' (a power of 2). The next kept block is reused if the
+    current one is full and a new block is only allocated once every kept block is in use.*/
+void* SessionArena::allocate(size_t bytes, size_t alignment) {
+    for(;this->currentBlock < this->blocks.size();this->currentBlock++, this->offset = 0) {
+        Block& block = this->blocks[this->currentBlock];
+        size_t start = (this->offset + alignment - 1) & ~(alignment - 1);
+        if(start + bytes <= block.size) {
+            this->offset = start + bytes;
+            this->allocationCount++;
+            return block.data + start;
+        }
+    }
+
+    //Every kept block is full. Oversized requests get a block of their own.
+    Block block;
+    block.size = qMax((size_t) BLOCK_SIZE, bytes + alignment);
+    block.data = static_cast<char*>(std::malloc(block.size));
+    if(block.data == NULL) qFatal("SessionArena: unable to allocate a %d byte block", (int) block.size);
+    this->blocks.append(block);
+
+    //malloc() returns memory aligned for any type, so the start of a new block needs no padding.
+    this->currentBlock = this->blocks.size() - 1;
+    this->offset = bytes;
+    this->allocationCount++;
+    return block.data;
+}
+
+/*Purpose: Frees everything allocated after 'mark' was taken.*/
+void SessionArena::rewind(Mark mark) {
+    this->currentBlock = mark.block;
+    this->offset = mark.offset;
+}
+
+/*Purpose: Frees everything allocated from the arena. The blocks are kept for the next Session.*/
+void SessionArena::release() {
+    this->currentBlock = 0;
+    this->offset = 0;
+    this->allocationCount = 0;
+}
@@ -0,0 +1,63 @@
+#ifndef SESSIONARENA_H
+#define SESSIONARENA_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <cstddef>
+#include <cstdlib>
+
+/*  The SessionArena class is a monotonic allocator for the transient working data of a Session. Allocating only moves an offset forward
+    inside a block, and everything allocated from the arena is freed in one step with release(). Released blocks are kept and reused, so
+    once the arena has grown to the size a Session needs, the Session no longer touches the general purpose heap at all. Scratch data
+    that only lives for one update can be freed early by taking a Mark before allocating it and rewinding to the Mark afterwards.
+
+    Only trivially destructible types (floats, ints, plain structs) may be allocated from the arena since no destructors are ever run.
+*/
+class SessionArena {
+
+    public:
+        static const int BLOCK_SIZE = 16 * 1024;               //The size (in bytes) of every block except oversized ones.
+
+        //A position in the arena that can be rewound to, freeing everything allocated after it.
+        struct Mark {
+            int block;
+            size_t offset;
+        };
+
+        //Constructor and Destructor
+        SessionArena();
+        ~SessionArena();
+
+        //Getter methods
+        qint64 getCapacity();
+        qint64 getBytesUsed();
+        int getAllocationCount();
+        Mark getMark();
+
+        //Setter methods
+        void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+        void rewind(Mark mark);
+        void release();
+
+        /*Purpose: Returns uninitialized space for 'count' objects of type T.*/
+        template<typename T> T* allocate(int count) {
+            return static_cast<T*>(allocate(sizeof(T) * (size_t) qMax(count, 0), alignof(T)));
+        }
+
+    private:
+        struct Block {
+            char* data;
+            size_t size;
+        };
+
+        QVector<Block> blocks;                                  //Every block the arena has allocated, in the order they are used.
+        int currentBlock;                                       //Index of the block currently being allocated from.
+        size_t offset;                                          //Offset of the first free byte in the current block.
+        int allocationCount;                                    //Number of allocations since the last release.
+
+        //Disable copying, the blocks are owned by exactly one arena.
+        SessionArena(const SessionArena&);
+        SessionArena& operator=(const SessionArena&);
+};
+
+#endif // SESSIONARENA_H
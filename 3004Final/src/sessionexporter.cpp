@@ -0,0 +1,188 @@
+#include "sessionexporter.h"
+
+//The columns of the metrics sheet, in order. They are also the keys of the JSON metrics.
+static const char* METRIC_COLUMNS[] = {"profile", "session", "date", "challengeLevel", "sessionLength", "achievementScore",
+                                       "averageCoherence", "lowPercent", "mediumPercent", "highPercent", "rejectedSamples", "png", "svg"};
+static const int NUM_METRIC_COLUMNS = sizeof(METRIC_COLUMNS) / sizeof(METRIC_COLUMNS[0]);
+
+//Constructor for the SessionExporter class.
+SessionExporter::SessionExporter(QString outputDirectory) {
+    this->outputDirectory = QDir(outputDirectory);
+    this->outputDirectory.mkpath(".");
+}
+
+//Getter methods
+int SessionExporter::getExportedCount() {return this->metrics.size();}
+
+/*  Purpose: Exports every Session of every Profile on the device, followed by the metrics sheet. Returns false if a file could not be
+    written.*/
+bool SessionExporter::exportAll() {
+    ProfileManager profileManager(100);
+    QStringList names = profileManager.getProfileNames();
+
+    for(int profileNumber = 0;profileNumber < names.size();profileNumber++) {
+        //Each Profile's files go in their own directory, numbered so that Profiles with the same name do not collide.
+        QString profileName = names.at(profileNumber);
+        QString directoryName = QString("profile_%1_%2").arg(profileNumber).arg(QString(profileName).replace(QRegExp("[^A-Za-z0-9]"), "_"));
+        this->outputDirectory.mkpath(directoryName);
+        QDir profileDirectory(this->outputDirectory.filePath(directoryName));
+
+        //Sessions are read on this thread (the store is not thread safe) and rendered in parallel one shard at a time.
+        HistoryStore store(profileManager.getProfileDirectory(profileNumber));
+        QVector<ExportJob> jobs = QVector<ExportJob>();
+        for(int i=0;i<store.count();i++) {
+            ExportJob job;
+            job.profileName = profileName;
+            job.sessionNumber = i;
+            job.session = store.getSessionAt(i);
+            job.baseName = profileDirectory.filePath(job.session.getDateTime().toString("'session_'yyyyMMdd_hhmmss_zzz"));
+            jobs.append(job);
+
+            if(jobs.size() == HistoryStore::SHARD_SIZE || i == store.count() - 1) {
+                exportBatch(jobs);
+                jobs.clear();
+            }
+        }
+    }
+    return writeMetrics();
+}
+
+/*Purpose: Draws the summary screen of 'session' (the same values as MainWindow::displaySessionSummary()) on an area of size 'size'.*/
+void SessionExporter::paintSummary(QPainter* painter, QSize size, Log session) {
+    painter->fillRect(QRect(QPoint(0, 0), size), Qt::white);
+    painter->setPen(Qt::black);
+
+    int length = session.getSessionLength();
+    float averageCoherence = length >= 5 ? session.getAverageCoherence() : 0;
+    QMap<QString, float> distribution = session.getCoherenceDistribution();
+
+    QStringList lines = QStringList();
+    lines << session.getDateTime().toString("Session dd:MM:yyyy hh:mm:ss")
+          << QString("Average Coherence: %1").arg(averageCoherence, 0, 'f', 2)
+          << QString("Length: %1:%2").arg(length / 60, 2, 10, QChar('0')).arg(length % 60, 2, 10, QChar('0'))
+          << QString("Achievement: %1").arg(session.getAchievementScore(), 0, 'f', 1)
+          << QString("Challenge Level: %1").arg(session.getChallengeLevel())
+          << QString("Low: %1%   Medium: %2%   High: %3%").arg(distribution.value("Low"), 0, 'f', 1)
+                .arg(distribution.value("Medium"), 0, 'f', 1).arg(distribution.value("High"), 0, 'f', 1);
+
+    int lineHeight = painter->fontMetrics().height();
+    for(int i=0;i<lines.size();i++) painter->drawText(16, 16 + lineHeight * (i + 1), lines.at(i));
+
+    //The HRV graph fills the rest of the summary.
+    QRectF graphArea(16, 32 + lineHeight * (lines.size() + 1), size.width() - 32, 0);
+    graphArea.setBottom(size.height() - 16);
+    painter->drawRect(graphArea);
+    HrvPlot::paint(painter, graphArea.adjusted(4, 4, -4, -4), session.getPulseData());
+}
+
+/*  Purpose: Runs the exporter for "--export <directory>" and prints how many Sessions were exported. Returns a non-zero exit code if the
+    arguments were wrong or a file could not be written.*/
+int SessionExporter::run(QStringList arguments) {
+    QString directory = arguments.value(arguments.indexOf("--export") + 1);
+    if(directory.isEmpty() || directory.startsWith("--")) {
+        qCritical("Usage: %s --export <directory>", qPrintable(arguments.value(0)));
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    SessionExporter exporter(directory);
+    bool succeeded = exporter.exportAll();
+    qInfo("Exported %d Session(s) to %s in %lld ms on %d threads", exporter.getExportedCount(), qPrintable(directory), timer.elapsed(),
+          QThreadPool::globalInstance()->maxThreadCount());
+    return succeeded ? 0 : 1;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE SESSIONEXPORTER CLASS***/
+
+/*Purpose: Renders 'jobs' in parallel and adds their metrics to the sheet in the order of 'jobs'.*/
+void SessionExporter::exportBatch(const QVector<ExportJob>& jobs) {
+    QList<QJsonObject> results = QtConcurrent::blockingMapped<QList<QJsonObject>>(jobs, &SessionExporter::exportJob);
+    foreach(QJsonObject result, results) {
+        //The sheet refers to the summaries relative to the output directory so that the export can be moved.
+        if(result.value("png").isString()) result["png"] = this->outputDirectory.relativeFilePath(result.value("png").toString());
+        if(result.value("svg").isString()) result["svg"] = this->outputDirectory.relativeFilePath(result.value("svg").toString());
+        this->metrics.append(result);
+
+        QStringList row = QStringList();
+        for(int i=0;i<NUM_METRIC_COLUMNS;i++) {
+            QString value = result.value(METRIC_COLUMNS[i]).toVariant().toString();
+            if(value.contains(',') || value.contains('"')) value = "\"" + value.replace("\"", "\"\"") + "\"";
+            row.append(value);
+        }
+        this->csvRows.append(row.join(','));
+    }
+}
+
+/*Purpose: Writes the PNG and SVG summaries of 'job' and returns its metrics. Runs on a worker thread.*/
+QJsonObject SessionExporter::exportJob(const ExportJob& job) {
+    Log session = job.session;
+    QSize size(SUMMARY_WIDTH, SUMMARY_HEIGHT);
+    QString pngPath = job.baseName + ".png";
+    QString svgPath = job.baseName + ".svg";
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    QPainter imagePainter(&image);
+    imagePainter.setRenderHint(QPainter::Antialiasing);
+    paintSummary(&imagePainter, size, session);
+    imagePainter.end();
+    if(!image.save(pngPath, "PNG")) pngPath.clear();
+
+    QSvgGenerator generator;
+    generator.setFileName(svgPath);
+    generator.setSize(size);
+    generator.setViewBox(QRect(QPoint(0, 0), size));
+    generator.setTitle(session.getDateTime().toString("Session dd:MM:yyyy hh:mm:ss"));
+    QPainter svgPainter;
+    if(svgPainter.begin(&generator)) {
+        paintSummary(&svgPainter, size, session);
+        svgPainter.end();
+    } else svgPath.clear();
+
+    int length = session.getSessionLength();
+    QMap<QString, float> distribution = session.getCoherenceDistribution();
+    QJsonObject result;
+    result["profile"] = job.profileName;
+    result["session"] = job.sessionNumber;
+    result["date"] = session.getDateTime().toString(Qt::ISODate);
+    result["challengeLevel"] = session.getChallengeLevel();
+    result["sessionLength"] = length;
+    result["achievementScore"] = session.getAchievementScore();
+    result["averageCoherence"] = length >= 5 ? session.getAverageCoherence() : 0;
+    result["lowPercent"] = distribution.value("Low");
+    result["mediumPercent"] = distribution.value("Medium");
+    result["highPercent"] = distribution.value("High");
+    result["rejectedSamples"] = session.getRejectedSamples();
+    result["png"] = pngPath.isEmpty() ? QJsonValue() : QJsonValue(pngPath);         //Made relative by exportBatch().
+    result["svg"] = svgPath.isEmpty() ? QJsonValue() : QJsonValue(svgPath);
+    return result;
+}
+
+/*Purpose: Writes the metrics of every exported Session to "metrics.csv" and "metrics.json". Returns false if a file could not be written.*/
+bool SessionExporter::writeMetrics() {
+    bool succeeded = true;
+    foreach(const QJsonValue& result, this->metrics) {
+        if(result.toObject().value("png").isNull() || result.toObject().value("svg").isNull()) succeeded = false;
+    }
+
+    QFile csvFile(this->outputDirectory.filePath("metrics.csv"));
+    if(csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        QTextStream out(&csvFile);
+        QStringList header = QStringList();
+        for(int i=0;i<NUM_METRIC_COLUMNS;i++) header.append(METRIC_COLUMNS[i]);
+        out << header.join(',') << "\n";
+        foreach(const QString& row, this->csvRows) out << row << "\n";
+    } else {
+        qWarning("Unable to write %s", qPrintable(csvFile.fileName()));
+        succeeded = false;
+    }
+
+    QFile jsonFile(this->outputDirectory.filePath("metrics.json"));
+    if(jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        jsonFile.write(QJsonDocument(this->metrics).toJson());
+    } else {
+        qWarning("Unable to write %s", qPrintable(jsonFile.fileName()));
+        succeeded = false;
+    }
+    return succeeded;
+}
@@ -0,0 +1,64 @@
+#ifndef SESSIONEXPORTER_H
+#define SESSIONEXPORTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QDir>
+#include <QRegExp>
+#include <QFile>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QImage>
+#include <QPainter>
+#include <QSvgGenerator>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include "log.h"
+#include "historystore.h"
+#include "profilemanager.h"
+#include "hrvplot.h"
+
+/*An ExportJob is one stored Session to export and the files it is exported to.*/
+struct ExportJob {
+    QString profileName;
+    int sessionNumber;                              //The position of the Session in its Profile's history.
+    Log session;
+    QString baseName;                               //The path of the exported files without the extension.
+};
+
+/*  The SessionExporter class writes the summary screen of every stored Session of every Profile to a PNG and an SVG file, plus one
+    metrics sheet in both CSV and JSON form. Summaries are drawn with a QPainter on a QImage and a QSvgGenerator instead of with the
+    device's widgets, so no window is ever created and the summaries can be rendered in parallel on every core. The Sessions are read
+    one history shard at a time, so only HistoryStore::SHARD_SIZE Logs are held in memory at once.
+*/
+class SessionExporter {
+
+    public:
+        static const int SUMMARY_WIDTH = 640;           //The size (in pixels) of the exported summaries.
+        static const int SUMMARY_HEIGHT = 360;
+
+        //Constructor
+        SessionExporter(QString outputDirectory);
+
+        //Getter methods
+        int getExportedCount();
+
+        bool exportAll();
+        static void paintSummary(QPainter* painter, QSize size, Log session);
+        static int run(QStringList arguments);
+
+    private:
+        QDir outputDirectory;
+        QJsonArray metrics;                             //One object per exported Session, in export order.
+        QStringList csvRows;                            //One row per exported Session, in export order.
+
+        //Helper methods
+        void exportBatch(const QVector<ExportJob>& jobs);
+        static QJsonObject exportJob(const ExportJob& job);
+        bool writeMetrics();
+};
+
+#endif // SESSIONEXPORTER_H
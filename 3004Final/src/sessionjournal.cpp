@@ -0,0 +1,241 @@
+#include "sessionjournal.h"
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//Written at the start of the journal so that a file written by a different version is not misread.
+static const quint32 JOURNAL_MAGIC = 0x48524a31;        //"HRJ1"
+
+//Constructor for the SessionJournal class.
+SessionJournal::SessionJournal(QString path, QObject* parent): QObject(parent) {
+    this->path = path;
+    this->active = false;
+    this->truncateNext = false;
+    this->writer.setMaxThreadCount(1);
+
+    this->flushTimer = new QTimer(this);
+    this->flushTimer->setSingleShot(true);
+    this->flushTimer->setInterval(FLUSH_INTERVAL);
+    connect(this->flushTimer, &QTimer::timeout, this, &SessionJournal::flush);
+}
+
+//Destructor for the SessionJournal class. Writes any records still in the batch.
+SessionJournal::~SessionJournal() {
+    flush();
+    this->writer.waitForDone();
+}
+
+//Getter methods
+int SessionJournal::getSyncCount() {return this->syncCount.loadAcquire();}
+
+/*Purpose: Returns whether the journal holds a Session that was interrupted before it ended. Waits for pending writes first.*/
+bool SessionJournal::hasRecoverableSession() {
+    this->writer.waitForDone();
+    return replay(NULL, NULL);
+}
+
+/*  Purpose: Rebuilds the summary Log of the interrupted Session from the journal and stores the position of the Profile it was recorded
+    for in 'profileIndex'. Returns an empty Log if there is no Session to recover.*/
+Log SessionJournal::recover(int* profileIndex) {
+    this->writer.waitForDone();
+    Log session = Log();
+    if(!replay(&session, profileIndex)) return Log();
+    return session;
+}
+
+//Setter methods
+
+/*  Purpose: Starts journaling a new Session. The previous journal is replaced by the first batch, which is written at once so the
+    Session is known to be active even if no other batch makes it to disk.*/
+void SessionJournal::begin(int challengeLevel, int pacerSpeed, int profileIndex) {
+    this->batch.clear();
+    this->truncateNext = true;
+    this->active = true;
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << QDateTime::currentDateTime() << (qint32) challengeLevel << (qint32) pacerSpeed << (qint32) profileIndex;
+    append(BeginRecord, payload);
+    flush();
+}
+
+/*  Purpose: Stops journaling and waits until every record is synced to disk, keeping the journal for recovery. Called when the device
+    loses power during a Session.*/
+void SessionJournal::close() {
+    if(!this->active) return;
+    flush();
+    this->writer.waitForDone();
+    this->active = false;
+}
+
+/*Purpose: Stops journaling and deletes the journal. Called when a Session ends normally or was recovered.*/
+void SessionJournal::discard() {
+    this->active = false;
+    this->flushTimer->stop();
+    this->batch.clear();
+    QString journalPath = this->path;
+    QtConcurrent::run(&this->writer, [journalPath]() {QFile::remove(journalPath);});
+}
+
+/***IMPLEMENTING THE SLOTS FOR THE SESSIONJOURNAL CLASS***/
+
+/*  Purpose: This slot is called on every tick of the Session. It adds the newest reading, and the coherence update on the ticks that
+    computed one, to the batch.*/
+void SessionJournal::record(Log currentLog) {
+    if(!this->active) return;
+    int length = currentLog.getSessionLength();
+    const QVector<float> pulseData = currentLog.getPulseData();
+    if(pulseData.isEmpty()) return;
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << (qint32) length << pulseData.last();
+    append(SampleRecord, payload);
+
+    //A new coherence score is computed every 5 seconds.
+    if(length > 0 && length % 5 == 0) {
+        payload.clear();
+        QDataStream coherence(&payload, QIODevice::WriteOnly);
+        coherence.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        coherence << (qint32) length << currentLog.getCoherenceScore() << currentLog.getAchievementScore()
+                  << currentLog.getCoherenceLevel() << currentLog.getWindowScores() << (qint32) currentLog.getRejectedSamples();
+        append(CoherenceRecord, payload);
+    }
+
+    if(this->batch.size() >= BATCH_BYTES) flush();
+    else if(!this->flushTimer->isActive()) this->flushTimer->start();
+}
+
+/*Purpose: Hands the batch to the writer thread, which appends it to the journal and syncs it to disk.*/
+void SessionJournal::flush() {
+    this->flushTimer->stop();
+    if(this->batch.isEmpty()) return;
+
+    QByteArray records = this->batch;
+    bool truncate = this->truncateNext;
+    QString journalPath = this->path;
+    this->batch.clear();
+    this->truncateNext = false;
+    QtConcurrent::run(&this->writer, [this, journalPath, records, truncate]() {
+        if(writeBatch(journalPath, records, truncate)) this->syncCount.ref();
+    });
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE SESSIONJOURNAL CLASS***/
+
+/*Purpose: Adds a record to the batch as its type, the size of its payload, the payload and a checksum of the payload.*/
+void SessionJournal::append(RecordType type, const QByteArray& payload) {
+    QDataStream out(&this->batch, QIODevice::WriteOnly | QIODevice::Append);
+    out << (quint8) type << (quint32) payload.size();
+    out.writeRawData(payload.constData(), payload.size());
+    out << (quint16) qChecksum(payload.constData(), payload.size());
+}
+
+/*  Purpose: Appends 'records' to the journal at 'path' (replacing the file if 'truncate') and syncs it to disk. Runs on the writer
+    thread. Returns false if the journal could not be written.*/
+bool SessionJournal::writeBatch(QString path, QByteArray records, bool truncate) {
+    QFile file(path);
+    if(!file.open(truncate ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning("Unable to write the Session journal to %s", qPrintable(path));
+        return false;
+    }
+    if(truncate) {
+        QDataStream out(&file);
+        out << JOURNAL_MAGIC;
+    }
+    file.write(records);
+    file.flush();
+
+    //Data only survives a power loss once the operating system has written it to the disk itself.
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+/*  Purpose: Reads the next record from 'in'. Returns false at the end of the journal or at a record that was only partly written or
+    fails its checksum.*/
+bool SessionJournal::readRecord(QDataStream& in, quint8& type, QByteArray& payload) {
+    quint32 size;
+    quint16 checksum;
+    in >> type >> size;
+    if(in.status() != QDataStream::Ok || size > (quint32) BATCH_BYTES) return false;
+    payload.resize(size);
+    if(in.readRawData(payload.data(), size) != (int) size) return false;
+    in >> checksum;
+    return in.status() == QDataStream::Ok && checksum == qChecksum(payload.constData(), payload.size());
+}
+
+/*  Purpose: Reads the journal and, if it holds an interrupted Session, rebuilds that Session's summary in 'session' and its Profile's
+    position in 'profileIndex' (either may be NULL). The HRV metrics and the averages of the window scores are recomputed from the
+    records. Returns whether there was a Session to recover.*/
+bool SessionJournal::replay(Log* session, int* profileIndex) {
+    QFile file(this->path);
+    if(!file.open(QIODevice::ReadOnly)) return false;
+    QDataStream in(&file);
+    quint32 magic;
+    in >> magic;
+    if(magic != JOURNAL_MAGIC) return false;
+
+    quint8 type;
+    QByteArray payload;
+    if(!readRecord(in, type, payload) || type != BeginRecord) return false;
+    if(session == NULL && profileIndex == NULL) return true;
+
+    QDataStream begin(payload);
+    begin.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    QDateTime date;
+    qint32 challengeLevel, pacerSpeed, profile;
+    begin >> date >> challengeLevel >> pacerSpeed >> profile;
+    if(profileIndex != NULL) *profileIndex = profile;
+    if(session == NULL) return true;
+
+    QVector<float> pulseData = QVector<float>();
+    HrvMetrics metrics = HrvMetrics();
+    QMap<QString, int> coherenceTimes = QMap<QString, int>();
+    QVector<float> windowScoreSums = QVector<float>();
+    int sessionLength = 0, scoreCount = 0, rejectedSamples = 0;
+    float achievementScore = 0;
+    while(readRecord(in, type, payload)) {
+        QDataStream record(payload);
+        record.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        qint32 length;
+        if(type == SampleRecord) {
+            float reading;
+            record >> length >> reading;
+            pulseData.append(reading);
+            metrics.addReading(reading);
+            sessionLength = length;
+        } else if(type == CoherenceRecord) {
+            float score;
+            QString level;
+            QVector<float> windowScores;
+            qint32 rejected;
+            record >> length >> score >> achievementScore >> level >> windowScores >> rejected;
+            coherenceTimes[level] += 5;
+            rejectedSamples = rejected;
+            if(windowScoreSums.size() < windowScores.size()) windowScoreSums.resize(windowScores.size());
+            for(int w=0;w<windowScores.size();w++) windowScoreSums[w] += windowScores.at(w);
+            scoreCount++;
+        }
+    }
+    for(int w=0;w<windowScoreSums.size();w++) windowScoreSums[w] /= scoreCount;
+
+    session->setDateTime(date);                         //The Session is stored under the time it began, not the time it was recovered.
+    session->setChallengeLevel(challengeLevel);
+    session->setPacerSpeed(pacerSpeed);
+    session->setCoherenceTimes(coherenceTimes);
+    session->setSessionLength(sessionLength);
+    session->setAchievementScore(achievementScore);
+    session->setPulseData(pulseData);
+    session->setRejectedSamples(rejectedSamples);
+    session->setWindowScores(windowScoreSums);
+    session->setHrvMetrics(metrics);
+    return true;
+}
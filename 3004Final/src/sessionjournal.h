@@ -0,0 +1,67 @@
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include <QObject>
+#include <QTimer>
+#include <QFile>
+#include <QByteArray>
+#include <QDataStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include "log.h"
+#include "hrvmetrics.h"
+
+/*  The SessionJournal class is a write-ahead log of the active Session, so that a Session interrupted by the battery running out (or the
+    device crashing) can be recovered the next time the device is turned on. Every tick of the Session appends a small record (the
+    cleaned reading, and the coherence update every 5 seconds) to an in-memory batch, which costs no I/O on the sampling path. A batch is
+    written and synced to disk on a worker thread once it holds BATCH_BYTES or FLUSH_INTERVAL ms after its first record, so at most
+    FLUSH_INTERVAL ms of a Session can be lost. The worker pool has a single thread so batches reach the file in order.
+
+    Every record carries a checksum, so a record torn by a power loss is detected and recovery stops at the last whole record.
+*/
+class SessionJournal: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static const int BATCH_BYTES = 4096;                //A batch is written once it holds this many bytes.
+        static const int FLUSH_INTERVAL = 2000;             //The longest a record waits before being written (in ms).
+
+        //The kinds of records in the journal.
+        enum RecordType {BeginRecord = 1, SampleRecord = 2, CoherenceRecord = 3};
+
+        //Constructor and destructor
+        SessionJournal(QString path, QObject* parent = nullptr);
+        ~SessionJournal();
+
+        //Getter methods
+        bool hasRecoverableSession();
+        Log recover(int* profileIndex);
+        int getSyncCount();
+
+        //Setter methods
+        void begin(int challengeLevel, int pacerSpeed, int profileIndex);
+        void close();
+        void discard();
+
+    public slots:
+        void record(Log currentLog);
+        void flush();
+
+    private:
+        QString path;                                       //The journal file.
+        QByteArray batch;                                   //Records waiting to be written.
+        QTimer* flushTimer;                                 //Writes the batch FLUSH_INTERVAL ms after its first record.
+        QThreadPool writer;                                 //The single thread that writes and syncs the batches.
+        bool active;                                        //Whether a Session is being journaled.
+        bool truncateNext;                                  //Whether the next batch starts a new journal file.
+        QAtomicInt syncCount;                               //The number of batches synced to disk.
+
+        //Helper methods
+        void append(RecordType type, const QByteArray& payload);
+        bool replay(Log* session, int* profileIndex);
+        static bool writeBatch(QString path, QByteArray batch, bool truncate);
+        static bool readRecord(QDataStream& in, quint8& type, QByteArray& payload);
+};
+
+#endif // SESSIONJOURNAL_H
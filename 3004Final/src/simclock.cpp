@@ -0,0 +1,71 @@
+#include "simclock.h"
+
+//Real time, 10 and 100 times faster, and as fast as possible.
+const int SimClock::SPEEDS[SimClock::NUM_SPEEDS] = {1, 10, 100, SimClock::MAX_SPEED};
+
+QElapsedTimer SimClock::wallClock;
+qint64 SimClock::segmentStart = 0;
+qint64 SimClock::segmentWallStart = 0;
+int SimClock::speed = 1;
+
+//Constructor for the SimClock class.
+SimClock::SimClock(): QObject(nullptr) {}
+
+/*Purpose: Returns the object that emits 'speedChanged'.*/
+SimClock* SimClock::instance() {
+    static SimClock clock;
+    return &clock;
+}
+
+//Getter methods
+
+/*Purpose: Returns the simulated time (in ms) since the clock was first read.*/
+qint64 SimClock::now() {
+    if(!wallClock.isValid()) wallClock.start();
+    return segmentStart + (wallClock.elapsed() - segmentWallStart) * speed;
+}
+
+int SimClock::getSpeed() {return speed;}
+
+/*Purpose: Returns the position of the current speed in SPEEDS, or the position of the fastest speed below it.*/
+int SimClock::getSpeedIndex() {
+    int index = 0;
+    while(index + 1 < NUM_SPEEDS && SPEEDS[index + 1] <= speed) index++;
+    return index;
+}
+
+//Returns how 'speed' is shown to the user, such as "10x" or "Max".
+QString SimClock::getSpeedName(int speed) {
+    if(speed >= MAX_SPEED) return "Max";
+    return QString("%1x").arg(speed);
+}
+
+/*Purpose: Returns the speed named 'name' ("1", "10", "100", "max", with or without a trailing "x"), or -1 if it is not one of SPEEDS.*/
+int SimClock::parseSpeed(QString name) {
+    name = name.trimmed().toLower();
+    if(name.endsWith('x')) name.chop(1);
+    if(name == "max") return MAX_SPEED;
+    bool ok = false;
+    int value = name.toInt(&ok);
+    for(int i=0;ok && i<NUM_SPEEDS;i++) {
+        if(SPEEDS[i] == value) return value;
+    }
+    return -1;
+}
+
+/*Purpose: Returns the real time (in ms, at least 1) that passes while the clock advances by 'simulatedInterval' ms at the current speed.*/
+int SimClock::toWallInterval(qint64 simulatedInterval) {
+    return (int) qMax((qint64) 1, (simulatedInterval + speed - 1) / speed);
+}
+
+//Setter methods
+
+/*Purpose: Runs the clock at 'speed' times real time from now on, without moving the simulated time.*/
+void SimClock::setSpeed(int speed) {
+    speed = qBound(1, speed, (int) MAX_SPEED);
+    if(speed == SimClock::speed) return;
+    segmentStart = now();
+    segmentWallStart = wallClock.elapsed();
+    SimClock::speed = speed;
+    emit instance()->speedChanged(speed);
+}
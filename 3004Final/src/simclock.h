@@ -0,0 +1,53 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <QtMath>
+
+/*  The SimClock class is the simulated time of the device, which every part of the device that models the passing of time reads instead
+    of the wall clock: Sessions tick once per simulated second, the battery drains per simulated millisecond and the breath pacer moves
+    with simulated time. The clock runs at a selectable multiple of real time, so a 30 minute Session or a full battery drain can be shown
+    in seconds while every component behaves exactly as it would in real time. Rendering is not simulated and keeps its real frame rate.
+
+    Simulated time is continuous across speed changes. Timers that wait for a simulated duration use toWallInterval() and re-arm when
+    'speedChanged' is emitted. The clock is only read on the GUI thread.
+*/
+class SimClock: public QObject {
+
+    Q_OBJECT
+
+    public:
+        //The selectable speeds, as multiples of real time. The last one is as fast as the 1 ms resolution of the device's timers allows.
+        static const int NUM_SPEEDS = 4;
+        static const int SPEEDS[NUM_SPEEDS];
+        static const int MAX_SPEED = 1000;
+
+        static SimClock* instance();
+
+        //Getter methods
+        static qint64 now();
+        static int getSpeed();
+        static int getSpeedIndex();
+        static QString getSpeedName(int speed);
+        static int parseSpeed(QString name);
+        static int toWallInterval(qint64 simulatedInterval);
+
+        //Setter methods
+        static void setSpeed(int speed);
+
+    signals:
+        void speedChanged(int speed);                   //Emitted after the speed changed.
+
+    private:
+        static QElapsedTimer wallClock;                 //Real time since the clock was first read.
+        static qint64 segmentStart;                     //The simulated time when the speed last changed.
+        static qint64 segmentWallStart;                 //The real time when the speed last changed.
+        static int speed;                               //Simulated milliseconds per real millisecond.
+
+        //Constructor
+        SimClock();
+};
+
+#endif // SIMCLOCK_H
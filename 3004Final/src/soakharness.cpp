@@ -0,0 +1,196 @@
+#include "soakharness.h"
+
+//The relative chance of picking each SoakHarness::Action. Navigation and the selector are the most common so that menus, Sessions and
+//summaries are all reached regularly, while power cycles are rare enough for Sessions to run for a while.
+static const int ACTION_WEIGHTS[] = {
+    2,          //Power
+    10,         //Up
+    10,         //Down
+    6,          //Left
+    6,          //Right
+    14,         //Selector
+    5,          //MenuButton
+    8,          //Back
+    1,          //Recharge
+    3,          //Sensor
+    12          //Wait
+};
+
+//Constructor for the SoakHarness class.
+SoakHarness::SoakHarness(MainWindow* window, quint32 seed, int actionCount, QObject* parent): QObject(parent), generator(seed) {
+    this->window = window;
+    this->window->setSensorSeed(seed);                  //The sensor readings must repeat along with the actions.
+    this->actionCount = actionCount;
+    this->actionsDone = 0;
+    this->failures = 0;
+    this->sensorBox = NULL;
+    this->scene = NULL;
+    this->maxSceneItems = 0;
+    this->scheduledDelay = 0;
+    for(int i=0;i<NUM_ACTIONS;i++) {
+        this->buttons[i] = NULL;
+        this->stats[i].count = 0;
+        this->stats[i].totalNs = 0;
+        this->stats[i].maxNs = 0;
+    }
+
+    this->actionTimer = new QTimer(this);
+    this->actionTimer->setSingleShot(true);
+    connect(actionTimer, &QTimer::timeout, this, &SoakHarness::performNextAction);
+}
+
+//Getter methods
+int SoakHarness::getFailureCount() {return this->failures;}
+
+/***IMPLEMENTING THE SLOTS FOR THE SOAKHARNESS CLASS***/
+
+/*Purpose: Finds the widgets of the window, records the starting memory counts and schedules the first action.*/
+void SoakHarness::start() {
+    const char* names[] = {"powerButton", "upButton", "downButton", "leftButton", "rightButton", "selectorButton", "menuButton",
+                           "backButton", "rechargeButton"};
+    for(int i=0;i<Sensor;i++) {
+        this->buttons[i] = this->window->findChild<QPushButton*>(names[i]);
+        if(this->buttons[i] == NULL) fail(QString("Unable to find the %1").arg(names[i]));
+    }
+    this->sensorBox = this->window->findChild<QComboBox*>("sensorBox");
+    QGraphicsView* graph = this->window->findChild<QGraphicsView*>("hrvGraph");
+    if(graph != NULL) this->scene = graph->scene();
+    if(this->sensorBox == NULL || this->scene == NULL) fail("Unable to find the sensor box or the graph scene");
+    if(this->failures > 0) {
+        emit finished(this->failures);
+        return;
+    }
+
+    for(int i=0;i<MemoryStats::NUM_SUBSYSTEMS;i++) {
+        this->baselineObjects[i] = MemoryStats::getObjects((MemoryStats::Subsystem) i);
+        this->startBytes[i] = MemoryStats::getBytes((MemoryStats::Subsystem) i);
+    }
+
+    qInfo("Soak: %d actions, Session tick every %d ms", this->actionCount, Session::getTickInterval());
+    this->runClock.start();
+    this->runStart = SimClock::now();
+    this->sinceScheduled.start();
+    this->actionTimer->start(0);
+}
+
+/*  Purpose: Performs one randomly chosen action, checks the invariants and schedules the next action. Waiting between actions lets the
+    Session, render and pacer timers run, so Sessions progress while the harness navigates.*/
+void SoakHarness::performNextAction() {
+    //Check that the event loop was not blocked past the scheduled time of this action.
+    qint64 lateness = this->sinceScheduled.elapsed() - this->scheduledDelay;
+    if(lateness > STALL_THRESHOLD) fail(QString("Event loop stalled for %1 ms before action %2").arg(lateness).arg(this->actionsDone));
+
+    Action action = pickAction();
+    QElapsedTimer latency;
+    latency.start();
+    perform(action);
+    qint64 elapsed = latency.nsecsElapsed();
+
+    ActionStats& actionStats = this->stats[action];
+    actionStats.count++;
+    actionStats.totalNs += elapsed;
+    actionStats.maxNs = qMax(actionStats.maxNs, elapsed);
+    if(elapsed / 1000000 > STALL_THRESHOLD) {
+        fail(QString("%1 took %2 ms at action %3").arg(getName(action)).arg(elapsed / 1000000).arg(this->actionsDone));
+    }
+
+    checkInvariants();
+    this->actionsDone++;
+    if(this->actionsDone >= this->actionCount) {
+        report();
+        emit finished(this->failures);
+        return;
+    }
+
+    //Waits last long enough for several Session ticks. Every other action follows after a short pause.
+    if(action == Wait) this->scheduledDelay = this->generator.bounded(TICK_INTERVAL, TICK_INTERVAL * 40);
+    else this->scheduledDelay = this->generator.bounded(TICK_INTERVAL);
+    this->sinceScheduled.restart();
+    this->actionTimer->start(this->scheduledDelay);
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE SOAKHARNESS CLASS***/
+
+SoakHarness::Action SoakHarness::pickAction() {
+    int totalWeight = 0;
+    for(int i=0;i<NUM_ACTIONS;i++) totalWeight += ACTION_WEIGHTS[i];
+
+    int pick = this->generator.bounded(totalWeight);
+    for(int i=0;i<NUM_ACTIONS;i++) {
+        if(pick < ACTION_WEIGHTS[i]) return (Action) i;
+        pick -= ACTION_WEIGHTS[i];
+    }
+    return Wait;
+}
+
+/*Purpose: Performs 'action'. Clicking a button emits "pressed" exactly like a real press, and every slot runs before click() returns.*/
+void SoakHarness::perform(Action action) {
+    if(action == Sensor) this->sensorBox->setCurrentIndex(1 - this->sensorBox->currentIndex());
+    else if(action != Wait) this->buttons[action]->click();
+}
+
+/*Purpose: Checks the memory and scene growth invariants described in the header.*/
+void SoakHarness::checkInvariants() {
+    //The Session and the tree of Menus are created once, so their object counts must never change.
+    MemoryStats::Subsystem fixed[] = {MemoryStats::SessionBuffers, MemoryStats::Menus};
+    for(int i=0;i<2;i++) {
+        qint64 objects = MemoryStats::getObjects(fixed[i]);
+        if(objects != this->baselineObjects[fixed[i]]) {
+            fail(QString("%1 went from %2 to %3 objects at action %4").arg(MemoryStats::getName(fixed[i]))
+                 .arg(this->baselineObjects[fixed[i]]).arg(objects).arg(this->actionsDone));
+            this->baselineObjects[fixed[i]] = objects;                  //Only report each change once.
+        }
+    }
+
+    if(MemoryStats::getObjects(MemoryStats::History) > HistoryStore::SHARD_SIZE) {
+        fail(QString("History holds %1 Logs at action %2").arg(MemoryStats::getObjects(MemoryStats::History)).arg(this->actionsDone));
+    }
+
+    //plotHRVGraph adds a point and a line for every tick and a time label every 5th tick, so at most 11 items every 5 ticks. No more ticks
+    //than this can have happened since the run started (in simulated time, since the harness may have changed the simulation speed).
+    int sceneItems = this->scene->items().size();
+    qint64 ticks = (SimClock::now() - this->runStart) / Session::getTickInterval() + 1;
+    if(sceneItems > 11 * ticks / 5 + 1 + SCENE_SLACK) {
+        fail(QString("The graph scene holds %1 items after at most %2 ticks").arg(sceneItems).arg(ticks));
+    }
+    this->maxSceneItems = qMax(this->maxSceneItems, sceneItems);
+}
+
+void SoakHarness::fail(QString message) {
+    this->failures++;
+    qWarning("Soak failure: %s", qPrintable(message));
+}
+
+/*Purpose: Prints the latency of each kind of action and the memory used by each subsystem over the run.*/
+void SoakHarness::report() {
+    qInfo("Soak finished %d actions in %lld ms with %d failure(s)", this->actionsDone, this->runClock.elapsed(), this->failures);
+    for(int i=0;i<NUM_ACTIONS;i++) {
+        const ActionStats& actionStats = this->stats[i];
+        if(actionStats.count == 0) continue;
+        qInfo("  %-10s %6d actions, mean %8.3f ms, max %8.3f ms", qPrintable(getName((Action) i)), actionStats.count,
+              actionStats.totalNs / (double) actionStats.count / 1000000.0, actionStats.maxNs / 1000000.0);
+    }
+    for(int i=0;i<MemoryStats::NUM_SUBSYSTEMS;i++) {
+        MemoryStats::Subsystem subsystem = (MemoryStats::Subsystem) i;
+        qInfo("  %-16s %8lld -> %8lld bytes (peak %lld)", qPrintable(MemoryStats::getName(subsystem)), this->startBytes[i],
+              MemoryStats::getBytes(subsystem), MemoryStats::getPeakBytes(subsystem));
+    }
+    qInfo("  Graph scene peaked at %d items", this->maxSceneItems);
+}
+
+QString SoakHarness::getName(Action action) {
+    switch(action) {
+        case Power: return "Power";
+        case Up: return "Up";
+        case Down: return "Down";
+        case Left: return "Left";
+        case Right: return "Right";
+        case Selector: return "Selector";
+        case MenuButton: return "Menu";
+        case Back: return "Back";
+        case Recharge: return "Recharge";
+        case Sensor: return "Sensor";
+        case Wait: return "Wait";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef SOAKHARNESS_H
+#define SOAKHARNESS_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QPushButton>
+#include <QComboBox>
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include "mainwindow.h"
+#include "memorystats.h"
+#include "session.h"
+#include "historystore.h"
+
+/*  The SoakHarness class drives a MainWindow through a long, randomized sequence of button presses and sensor changes to catch leaks
+    and stalls in the button driven state machine. The sequence and the sensor readings are generated from a seed so a failing run can
+    be repeated exactly. The harness only uses the widgets of the window (found by their object names), so it exercises the same code
+    paths as a user would.
+
+    After every action the harness checks that:
+        - the action and the event loop did not stall for more than STALL_THRESHOLD ms,
+        - the objects counted by MemoryStats for the Session buffers and the Menus did not change (they are created once),
+        - the cached History shard never holds more than HistoryStore::SHARD_SIZE Logs,
+        - the graph scene holds no more than the 11 items every 5 Session ticks (a point and a line per tick, a time label every 5th) that
+          could have happened since the harness started.
+    Sessions are run at accelerated time (see TICK_INTERVAL) so that long Sessions fit in a short run.
+*/
+class SoakHarness: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static const int TICK_INTERVAL = 20;                    //The Session tick interval (in ms) used during a soak run.
+        static const int STALL_THRESHOLD = 250;                 //The longest an action or the event loop may block (in ms).
+        static const int SCENE_SLACK = 16;                      //Extra scene items allowed on top of the per tick bound.
+
+        //Constructor
+        SoakHarness(MainWindow* window, quint32 seed, int actionCount, QObject* parent=0);
+
+        //Getter methods
+        int getFailureCount();
+
+    signals:
+        void finished(int failures);
+
+    public slots:
+        void start();
+
+    private slots:
+        void performNextAction();
+
+    private:
+        //The actions the harness can take. Every action except Sensor and Wait presses one of the device's buttons.
+        enum Action {Power, Up, Down, Left, Right, Selector, MenuButton, Back, Recharge, Sensor, Wait, NUM_ACTIONS};
+
+        //Latency statistics for one kind of Action.
+        struct ActionStats {
+            int count;
+            qint64 totalNs;
+            qint64 maxNs;
+        };
+
+        MainWindow* window;                                     //The window being driven.
+        QRandomGenerator generator;                             //Seeded generator the action sequence is drawn from.
+        int actionCount;                                        //The number of actions to perform.
+        int actionsDone;                                        //The number of actions performed so far.
+        int failures;                                           //The number of failed checks.
+
+        QPushButton* buttons[NUM_ACTIONS];                      //The button pressed by each Action (NULL for Sensor and Wait).
+        QComboBox* sensorBox;
+        QGraphicsScene* scene;
+
+        ActionStats stats[NUM_ACTIONS];
+        qint64 baselineObjects[MemoryStats::NUM_SUBSYSTEMS];    //Objects counted by MemoryStats when the run started.
+        qint64 startBytes[MemoryStats::NUM_SUBSYSTEMS];         //Bytes counted by MemoryStats when the run started.
+        int maxSceneItems;                                      //The most items the graph scene has held.
+
+        QTimer* actionTimer;                                    //Schedules the next action.
+        int scheduledDelay;                                     //The delay the next action was scheduled with (in ms).
+        QElapsedTimer sinceScheduled;                           //Time since the next action was scheduled.
+        QElapsedTimer runClock;                                 //Time since the run started.
+        qint64 runStart;                                        //The SimClock time the run started at.
+
+        //Helper methods
+        Action pickAction();
+        void perform(Action action);
+        void checkInvariants();
+        void fail(QString message);
+        void report();
+        static QString getName(Action action);
+};
+
+#endif // SOAKHARNESS_H
@@ -0,0 +1,72 @@
+#include "streampublisher.h"
+
+/*  Purpose: Constructor for the StreamPublisher class. Creates the shared memory segment, or takes over one left behind by a crashed
+    publisher. Publishes nothing if another process is already publishing.*/
+StreamPublisher::StreamPublisher(QObject* parent): QObject(parent), memory(StreamRing::KEY),
+        lock(QDir::temp().filePath(QString(StreamRing::KEY) + ".lock")) {
+    this->header = NULL;
+    if(!this->lock.tryLock(0)) {
+        qWarning("Unable to publish the Session stream: another process is already publishing it");
+        return;
+    }
+    if(!this->memory.create(StreamRing::SEGMENT_SIZE) && !(this->memory.error() == QSharedMemory::AlreadyExists && this->memory.attach())) {
+        qWarning("Unable to publish the Session stream: %s", qPrintable(this->memory.errorString()));
+        return;
+    }
+    if(this->memory.size() < StreamRing::SEGMENT_SIZE) {
+        qWarning("Unable to publish the Session stream: the existing segment is too small");
+        this->memory.detach();
+        return;
+    }
+
+    //Start an empty ring. Readers check the magic number before reading anything else. Holding the lock means that a segment which
+    //already has a valid magic number was left behind by a crashed publisher, so no live publisher is writing it.
+    this->header = static_cast<StreamRing::Header*>(this->memory.data());
+    this->header->magic = 0;
+    new (&this->header->writeIndex) std::atomic<quint64>(0);
+    StreamRing::Slot* ring = StreamRing::slotArray(this->header);
+    for(int i=0;i<StreamRing::CAPACITY;i++) new (&ring[i].sequence) std::atomic<quint64>(0);
+    this->header->capacity = StreamRing::CAPACITY;
+    std::atomic_thread_fence(std::memory_order_release);
+    this->header->magic = StreamRing::MAGIC;
+}
+
+//Destructor for the StreamPublisher class. The segment is removed once the last reader detaches.
+StreamPublisher::~StreamPublisher() {
+    if(this->header != NULL) this->header->magic = 0;
+}
+
+//Getter methods
+bool StreamPublisher::isPublishing() {return this->header != NULL;}
+quint64 StreamPublisher::getPublishedCount() {return this->header == NULL ? 0 : this->header->writeIndex.load(std::memory_order_relaxed);}
+
+/***IMPLEMENTING THE SLOTS FOR THE STREAMPUBLISHER CLASS***/
+
+/*Purpose: Writes the tick described by 'currentLog' into the next slot of the ring, overwriting the oldest sample once the ring is full.*/
+void StreamPublisher::publish(Log currentLog) {
+    if(this->header == NULL) return;
+
+    StreamRing::Sample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    sample.sessionLength = currentLog.getSessionLength();
+    const QVector<float> pulseData = currentLog.getPulseData();                 //Shares the Session's data, nothing is copied.
+    sample.pulse = pulseData.isEmpty() ? 0 : pulseData.last();
+    sample.coherenceScore = currentLog.getCoherenceScore();
+    sample.achievementScore = currentLog.getAchievementScore();
+    QString level = currentLog.getCoherenceLevel();
+    if(level == "Low") sample.coherenceLevel = StreamRing::Low;
+    else if(level == "Medium") sample.coherenceLevel = StreamRing::Medium;
+    else if(level == "High") sample.coherenceLevel = StreamRing::High;
+    else sample.coherenceLevel = StreamRing::NoLevel;
+    sample.rejectedSamples = currentLog.getRejectedSamples();
+
+    //There is a single publisher, so the write index only needs to be published, not claimed.
+    quint64 index = this->header->writeIndex.load(std::memory_order_relaxed);
+    StreamRing::Slot& slot = StreamRing::slotArray(this->header)[index % StreamRing::CAPACITY];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);             //Odd: the slot is being written.
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample = sample;
+    slot.sequence.store(2 * (index + 1), std::memory_order_release);           //Even: the slot holds sample 'index'.
+    this->header->writeIndex.store(index + 1, std::memory_order_release);
+}
@@ -0,0 +1,42 @@
+#ifndef STREAMPUBLISHER_H
+#define STREAMPUBLISHER_H
+
+#include <QObject>
+#include <QSharedMemory>
+#include <QLockFile>
+#include <QDir>
+#include <QDateTime>
+#include <new>
+#include "streamring.h"
+#include "log.h"
+
+/*  The StreamPublisher class writes every tick of the Session into the shared memory ring described in streamring.h so that other local
+    processes (see StreamReader) can follow the Session live. Publishing a tick only copies one small sample into the ring, it never
+    waits for the readers and never takes a lock, so any number of readers can attach without slowing the device down.
+
+    Only one process may publish at a time. A lock file, which Qt considers stale once the process holding it has died, tells a live
+    publisher apart from a segment left behind by a crashed one.
+*/
+class StreamPublisher: public QObject {
+
+    Q_OBJECT
+
+    public:
+        //Constructor and destructor
+        StreamPublisher(QObject* parent=0);
+        ~StreamPublisher();
+
+        //Getter methods
+        bool isPublishing();
+        quint64 getPublishedCount();
+
+    public slots:
+        void publish(Log currentLog);
+
+    private:
+        QSharedMemory memory;
+        QLockFile lock;                                 //Held while this process publishes.
+        StreamRing::Header* header;                     //The start of the segment, or NULL if it could not be created.
+};
+
+#endif // STREAMPUBLISHER_H
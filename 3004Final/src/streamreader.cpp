@@ -0,0 +1,121 @@
+#include "streamreader.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QTimer>
+#include <QTextStream>
+
+//How often (in ms) the "--read-stream" mode polls the ring and retries attaching.
+static const int POLL_INTERVAL = 100;
+
+//Constructor for the StreamReader class.
+StreamReader::StreamReader(): memory(StreamRing::KEY) {
+    this->header = NULL;
+    this->nextIndex = 0;
+    this->missedCount = 0;
+}
+
+//Destructor for the StreamReader class.
+StreamReader::~StreamReader() {
+    detach();
+}
+
+//Getter methods
+bool StreamReader::isAttached() {return this->header != NULL;}
+quint64 StreamReader::getMissedCount() {return this->missedCount;}
+
+//Setter methods
+
+/*Purpose: Attaches to a published stream. Reading starts with the newest sample. Returns false if no publisher is running.*/
+bool StreamReader::attach() {
+    if(this->header != NULL) return true;
+    if(!this->memory.attach(QSharedMemory::ReadOnly)) return false;
+
+    const StreamRing::Header* segment = static_cast<const StreamRing::Header*>(this->memory.constData());
+    if(this->memory.size() < StreamRing::SEGMENT_SIZE || segment->magic != StreamRing::MAGIC || segment->capacity != StreamRing::CAPACITY) {
+        this->memory.detach();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    this->header = segment;
+    quint64 written = this->header->writeIndex.load(std::memory_order_acquire);
+    this->nextIndex = written > 0 ? written - 1 : 0;
+    this->missedCount = 0;
+    return true;
+}
+
+void StreamReader::detach() {
+    this->header = NULL;
+    if(this->memory.isAttached()) this->memory.detach();
+}
+
+/*  Purpose: Copies the next sample of the stream into 'sample'. Returns false if there is no new sample yet, if the slot could not be
+    read in MAX_READ_ATTEMPTS tries, or if the publisher stopped, in which case the reader detaches.*/
+bool StreamReader::read(StreamRing::Sample* sample) {
+    if(this->header == NULL) return false;
+
+    for(int attempt=0;attempt<MAX_READ_ATTEMPTS;attempt++) {
+        //The publisher clears the magic number when it stops or restarts the ring.
+        if(this->header->magic != StreamRing::MAGIC) {
+            detach();
+            return false;
+        }
+
+        quint64 written = this->header->writeIndex.load(std::memory_order_acquire);
+        if(this->nextIndex >= written) return false;
+
+        //Skip the samples that were overwritten before they could be read.
+        if(written - this->nextIndex > (quint64) StreamRing::CAPACITY) {
+            this->missedCount += written - StreamRing::CAPACITY - this->nextIndex;
+            this->nextIndex = written - StreamRing::CAPACITY;
+        }
+
+        const StreamRing::Slot& slot = StreamRing::slotArray(this->header)[this->nextIndex % StreamRing::CAPACITY];
+        quint64 expected = 2 * (this->nextIndex + 1);
+        quint64 before = slot.sequence.load(std::memory_order_acquire);
+        *sample = slot.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        quint64 after = slot.sequence.load(std::memory_order_relaxed);
+
+        if(before == expected && after == expected) {
+            this->nextIndex++;
+            return true;
+        }
+        //The slot was rewritten with a later sample while it was being copied, so this reader fell behind. Try again from the oldest sample.
+    }
+
+    //The slot never held the sample, which happens when the publisher died while writing it. Skip the sample so the next read moves on.
+    this->missedCount++;
+    this->nextIndex++;
+    return false;
+}
+
+/*  Purpose: Runs "--read-stream", which prints every sample of the published stream as a line of comma separated values until it is
+    stopped. Waits for a publisher if none is running yet.*/
+int StreamReader::run(QStringList arguments) {
+    Q_UNUSED(arguments);
+    StreamReader reader;
+    QTextStream out(stdout);
+    out << "timestamp,sessionLength,pulse,coherenceScore,achievementScore,coherenceLevel,rejectedSamples\n";
+    out.flush();
+
+    QTimer poll;
+    QObject::connect(&poll, &QTimer::timeout, [&reader, &out]() {
+        if(!reader.isAttached()) {
+            if(!reader.attach()) return;
+            qInfo("Attached to the Session stream");
+        }
+
+        StreamRing::Sample sample;
+        quint64 missed = reader.getMissedCount();
+        while(reader.read(&sample)) {
+            out << sample.timestamp << ',' << sample.sessionLength << ',' << sample.pulse << ',' << sample.coherenceScore << ','
+                << sample.achievementScore << ',' << sample.coherenceLevel << ',' << sample.rejectedSamples << '\n';
+        }
+        out.flush();
+        if(reader.getMissedCount() > missed) qWarning("Missed %llu samples", reader.getMissedCount() - missed);
+        if(!reader.isAttached()) qInfo("The Session stream stopped, waiting for a new one");
+    });
+    poll.start(POLL_INTERVAL);
+    return QCoreApplication::exec();
+}
@@ -0,0 +1,41 @@
+#ifndef STREAMREADER_H
+#define STREAMREADER_H
+
+#include <QSharedMemory>
+#include <QStringList>
+#include "streamring.h"
+
+/*  The StreamReader class follows the live Session stream written by a StreamPublisher in another process. Reading never blocks the
+    publisher: a sample is copied out of its slot and kept only if the slot's sequence number shows it was not rewritten during the copy.
+    A reader that falls more than StreamRing::CAPACITY samples behind skips ahead to the oldest sample still in the ring and counts the
+    samples it missed. A slot that is never completed (because the publisher died while writing it) is skipped after
+    MAX_READ_ATTEMPTS tries, so a reader never waits on a dead publisher.
+*/
+class StreamReader {
+
+    public:
+        static const int MAX_READ_ATTEMPTS = 16;        //Times a slot is copied before giving up on it.
+
+        //Constructor and destructor
+        StreamReader();
+        ~StreamReader();
+
+        //Getter methods
+        bool isAttached();
+        quint64 getMissedCount();
+
+        //Setter methods
+        bool attach();
+        void detach();
+
+        bool read(StreamRing::Sample* sample);
+        static int run(QStringList arguments);
+
+    private:
+        QSharedMemory memory;
+        const StreamRing::Header* header;               //The start of the segment, or NULL if not attached.
+        quint64 nextIndex;                              //The stream index of the next sample to read.
+        quint64 missedCount;                            //Samples overwritten before this reader got to them.
+};
+
+#endif // STREAMREADER_H
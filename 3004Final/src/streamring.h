@@ -0,0 +1,56 @@
+#ifndef STREAMRING_H
+#define STREAMRING_H
+
+#include <QtGlobal>
+#include <atomic>
+
+/*  The layout of the shared memory segment the live Session stream is published in. It is a ring buffer of CAPACITY slots written by a
+    single StreamPublisher and read by any number of StreamReaders without locks:
+
+        - Each slot is guarded by a sequence number (a seqlock). The publisher makes it odd while the slot is being written and sets it to
+          2 * (index + 1) once the sample with that stream index is complete, so a reader can tell whether a slot holds the sample it
+          wants, is being written, or was already overwritten by a later sample.
+        - 'writeIndex' in the header is the index of the next sample to be written. It is only advanced after the slot is complete.
+
+    The segment only holds plain data and address-free atomics, so it can be mapped by several processes at once.
+*/
+namespace StreamRing {
+
+    static const char* const KEY = "3004Final-session-stream";     //The QSharedMemory key of the segment.
+    static const quint32 MAGIC = 0x53545231;                        //"STR1", changed whenever the layout changes.
+    static const int CAPACITY = 1024;                               //The number of samples the ring holds.
+
+    //The coherence levels, as they are stored in a StreamSample.
+    enum Level {NoLevel, Low, Medium, High};
+
+    //One tick of a Session.
+    struct Sample {
+        qint64 timestamp;                   //When the tick was published (ms since the epoch).
+        qint32 sessionLength;               //Seconds since the Session began.
+        float pulse;                        //The latest (filtered) pulse reading.
+        float coherenceScore;               //The most recent coherence score.
+        float achievementScore;
+        qint32 coherenceLevel;              //One of StreamRing::Level.
+        qint32 rejectedSamples;             //Readings rejected by the artifact filter so far.
+    };
+
+    struct Slot {
+        std::atomic<quint64> sequence;
+        Sample sample;
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 capacity;
+        std::atomic<quint64> writeIndex;
+    };
+
+    //The size of the whole segment.
+    static const int SEGMENT_SIZE = sizeof(Header) + CAPACITY * sizeof(Slot);
+
+    //The slots follow the header. (Not named "slots", which Qt defines as a macro.)
+    inline Slot* slotArray(Header* header) {return reinterpret_cast<Slot*>(header + 1);}
+    inline const Slot* slotArray(const Header* header) {return reinterpret_cast<const Slot*>(header + 1);}
+}
+
+#endif // STREAMRING_H
@@ -0,0 +1,151 @@
+#include "thresholdtuner.h"
+
+//Constructor for the ThresholdTuner class.
+ThresholdTuner::ThresholdTuner(quint32 seed, int streamsPerProfile) {
+    this->seed = seed;
+    this->streamsPerProfile = qMax(streamsPerProfile, 1);
+}
+
+//Getter methods
+int ThresholdTuner::getScoreCount() {return this->lowScores.size() + this->highScores.size();}
+
+/*  Purpose: Generates the "Low" and "High" streams in parallel and keeps their sorted coherence scores. The even streams use the "Low"
+    profile and the odd streams the "High" profile.*/
+void ThresholdTuner::generateCorpus() {
+    //Sessions on the worker threads only read the thresholds, so the table must be filled before they start.
+    if(Session::CHALLENGE_THRESHOLDS.isEmpty()) Session::initializeThresholds();
+
+    QVector<int> streams = QVector<int>();
+    for(int i=0;i<2 * this->streamsPerProfile;i++) streams.append(i);
+
+    quint32 firstSeed = this->seed;
+    QList<QVector<float>> scores = QtConcurrent::blockingMapped<QList<QVector<float>>>(streams, [firstSeed](int stream) {
+        return scoreStream(stream % 2 == 0 ? "Low" : "High", firstSeed + stream, STREAM_LENGTH);
+    });
+
+    this->lowScores.clear();
+    this->highScores.clear();
+    for(int i=0;i<scores.size();i++) {
+        if(i % 2 == 0) this->lowScores += scores.at(i);
+        else this->highScores += scores.at(i);
+    }
+    std::sort(this->lowScores.begin(), this->lowScores.end());
+    std::sort(this->highScores.begin(), this->highScores.end());
+}
+
+/*  Purpose: Evaluates every threshold pair for 'level' with low >= 'minLow', high >= 'minHigh' and low < high, in parallel. Returns the
+    candidates sorted best first.*/
+QVector<ThresholdCandidate> ThresholdTuner::sweep(int level, float minLow, float minHigh) {
+    //Each task sweeps every "High" threshold for one "Low" threshold.
+    QVector<int> lowSteps = QVector<int>();
+    for(int step = qCeil(minLow * STEPS_PER_POINT);step < MAX_SCORE * STEPS_PER_POINT;step++) lowSteps.append(step);
+
+    QList<QVector<ThresholdCandidate>> rows = QtConcurrent::blockingMapped<QList<QVector<ThresholdCandidate>>>(lowSteps,
+        [this, level, minHigh](int lowStep) {
+            QVector<ThresholdCandidate> row = QVector<ThresholdCandidate>();
+            int firstHighStep = qMax(lowStep + 1, qCeil(minHigh * STEPS_PER_POINT));
+            for(int highStep = firstHighStep;highStep <= MAX_SCORE * STEPS_PER_POINT;highStep++) {
+                row.append(evaluate(level, lowStep / (float) STEPS_PER_POINT, highStep / (float) STEPS_PER_POINT));
+            }
+            return row;
+        });
+
+    QVector<ThresholdCandidate> candidates = QVector<ThresholdCandidate>();
+    foreach(const QVector<ThresholdCandidate>& row, rows) candidates += row;
+    std::stable_sort(candidates.begin(), candidates.end(), [](const ThresholdCandidate& a, const ThresholdCandidate& b) {
+        return a.score > b.score;
+    });
+    return candidates;
+}
+
+/*  Purpose: Scores the pair ('low', 'high') for challenge level 'level' using the precomputed scores. A score is "Low" when it is below
+    'low' and "High" when it is above 'high', exactly like Session::updateCoherence().*/
+ThresholdCandidate ThresholdTuner::evaluate(int level, float low, float high) {
+    ThresholdCandidate candidate;
+    candidate.low = low;
+    candidate.high = high;
+
+    int belowLow = std::lower_bound(this->lowScores.begin(), this->lowScores.end(), low) - this->lowScores.begin();
+    int aboveHigh = this->highScores.end() - std::upper_bound(this->highScores.begin(), this->highScores.end(), high);
+    candidate.lowRate = this->lowScores.isEmpty() ? 0 : belowLow / (float) this->lowScores.size();
+    candidate.highRate = this->highScores.isEmpty() ? 0 : aboveHigh / (float) this->highScores.size();
+
+    float separation = (candidate.lowRate + candidate.highRate) / 2.0;
+    candidate.score = separation - qAbs(candidate.highRate - getTargetHighRate(level));
+    return candidate;
+}
+
+/*  Purpose: Runs the tuner for "--tune-thresholds <seed> [streams]" and prints the best candidates of each challenge level followed by
+    the best table. Each level's thresholds are kept at or above the previous level's so the levels stay in order of difficulty.*/
+int ThresholdTuner::run(QStringList arguments) {
+    int index = arguments.indexOf("--tune-thresholds");
+    bool seedOk = false;
+    quint32 seed = arguments.value(index + 1).toUInt(&seedOk);
+    int streams = arguments.value(index + 2, QString::number(DEFAULT_STREAMS)).toInt();
+    if(!seedOk || streams <= 0) {
+        qCritical("Usage: %s --tune-thresholds <seed> [streams]", qPrintable(arguments.value(0)));
+        return 2;
+    }
+
+    ThresholdTuner tuner(seed, streams);
+    QElapsedTimer timer;
+    timer.start();
+    tuner.generateCorpus();
+    qInfo("Generated %d coherence scores from %d streams in %lld ms on %d threads", tuner.getScoreCount(), 2 * streams,
+          timer.restart(), QThreadPool::globalInstance()->maxThreadCount());
+
+    QVector<ThresholdCandidate> best = QVector<ThresholdCandidate>();
+    float minLow = 0, minHigh = 0;
+    for(int level = 1;level <= Session::CHALLENGE_THRESHOLDS.size();level++) {
+        QVector<ThresholdCandidate> candidates = tuner.sweep(level, minLow, minHigh);
+        if(candidates.isEmpty()) break;
+
+        qInfo("Challenge level %d (target High rate %.2f), %d candidates:", level, getTargetHighRate(level), candidates.size());
+        for(int i=0;i<qMin((int) RESULTS_SHOWN, candidates.size());i++) {
+            const ThresholdCandidate& candidate = candidates.at(i);
+            qInfo("  Low %5.1f  High %5.1f  score %.3f  (Low streams %.1f%% Low, High streams %.1f%% High)", candidate.low,
+                  candidate.high, candidate.score, candidate.lowRate * 100.0, candidate.highRate * 100.0);
+        }
+        best.append(candidates.first());
+        minLow = candidates.first().low;
+        minHigh = candidates.first().high;
+    }
+    qInfo("Swept every challenge level in %lld ms. Best table:", timer.elapsed());
+
+    for(int i=0;i<best.size();i++) {
+        qInfo("    CHALLENGE_THRESHOLDS[%d][\"Low\"] = %.1f;", i + 1, best.at(i).low);
+        qInfo("    CHALLENGE_THRESHOLDS[%d][\"High\"] = %.1f;", i + 1, best.at(i).high);
+    }
+    return 0;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE THRESHOLDTUNER CLASS***/
+
+/*  Purpose: Runs a headless Session fed by a Datagen with profile 'coherence' and seed 'seed' for 'length' seconds and returns every
+    coherence score it computed. The Session is ticked directly instead of by its timer, so no event loop is needed.*/
+QVector<float> ThresholdTuner::scoreStream(QString coherence, quint32 seed, int length) {
+    Session session;
+    Datagen generator(coherence);
+    generator.setSeed(seed);
+    QObject::connect(&session, &Session::getSensorReading, &generator, &Datagen::getSensorReading);
+    QObject::connect(&generator, &Datagen::sendSensorReading, &session, &Session::updatePulseData);
+
+    QVector<float> scores = QVector<float>();
+    scores.reserve(length / 5);
+    QObject::connect(&session, &Session::updateSessionDisplay, [&scores](Log currentLog) {
+        if(currentLog.getSessionLength() > 0 && currentLog.getSessionLength() % 5 == 0) scores.append(currentLog.getCoherenceScore());
+    });
+
+    for(int i=0;i<=length;i++) session.updateSessionData();
+    return scores;
+}
+
+//Higher challenge levels should make "High" coherence harder to reach.
+float ThresholdTuner::getTargetHighRate(int level) {
+    switch(level) {
+        case 1: return 0.9;
+        case 2: return 0.7;
+        case 3: return 0.5;
+        default: return 0.3;
+    }
+}
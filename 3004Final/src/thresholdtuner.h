@@ -0,0 +1,64 @@
+#ifndef THRESHOLDTUNER_H
+#define THRESHOLDTUNER_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QtConcurrent>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <algorithm>
+#include "session.h"
+#include "datagen.h"
+#include "log.h"
+
+/*A ThresholdCandidate is one ("Low", "High") threshold pair for a challenge level and how well it did on the corpus.*/
+struct ThresholdCandidate {
+    float low;                                      //Scores below this are "Low" coherence.
+    float high;                                     //Scores above this are "High" coherence.
+    float lowRate;                                  //Fraction of the scores of "Low" streams classified as "Low".
+    float highRate;                                 //Fraction of the scores of "High" streams classified as "High".
+    float score;                                    //How well the pair separates the streams (higher is better).
+};
+
+/*  The ThresholdTuner class searches for CHALLENGE_THRESHOLDS tables. It generates a corpus of seeded pulse streams from the "Low" and
+    "High" Datagen profiles and runs each through a headless Session once, keeping the coherence scores. Since the thresholds only decide
+    the level a score maps to, every candidate threshold pair is then evaluated against the same sorted scores with two binary searches.
+
+    A candidate is scored by its balanced separation (the mean of the fraction of "Low" stream scores classified "Low" and the fraction
+    of "High" stream scores classified "High"), minus how far its fraction of "High" scores is from the target of its challenge level,
+    so that the higher levels are harder to reach "High" coherence in. Both the corpus and the sweep run on every core with QtConcurrent.
+*/
+class ThresholdTuner {
+
+    public:
+        static const int DEFAULT_STREAMS = 32;          //The default number of streams generated from each Datagen profile.
+        static const int STREAM_LENGTH = 300;           //The length of each stream (in seconds of Session time).
+        static const int MAX_SCORE = 16;                //Coherence scores are between 0 and 16.
+        static const int STEPS_PER_POINT = 10;          //Candidate thresholds are swept in steps of 1/STEPS_PER_POINT.
+        static const int RESULTS_SHOWN = 5;             //The number of best candidates printed for each challenge level.
+
+        //Constructor
+        ThresholdTuner(quint32 seed, int streamsPerProfile = DEFAULT_STREAMS);
+
+        //Getter methods
+        int getScoreCount();
+
+        void generateCorpus();
+        QVector<ThresholdCandidate> sweep(int level, float minLow, float minHigh);
+        ThresholdCandidate evaluate(int level, float low, float high);
+
+        static int run(QStringList arguments);
+
+    private:
+        quint32 seed;                                   //The seed of the first stream. Stream i uses seed + i.
+        int streamsPerProfile;
+        QVector<float> lowScores;                       //Sorted coherence scores of every "Low" stream.
+        QVector<float> highScores;                      //Sorted coherence scores of every "High" stream.
+
+        //Helper methods
+        static QVector<float> scoreStream(QString coherence, quint32 seed, int length);
+        static float getTargetHighRate(int level);
+};
+
+#endif // THRESHOLDTUNER_H
@@ -0,0 +1,122 @@
+#include "tracer.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QFile>
+#include <QTextStream>
+#include <chrono>
+
+//Tracing starts disabled.
+std::atomic<bool> Tracer::enabled(false);
+QMutex Tracer::buffersMutex;
+QVector<Tracer::ThreadBuffer*> Tracer::buffers;
+
+//Every timestamp is relative to the first time the clock is read.
+static const std::chrono::steady_clock::time_point CLOCK_START = std::chrono::steady_clock::now();
+
+//Getter methods
+bool Tracer::isCompiledIn() {
+#ifdef HRV_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+qint64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - CLOCK_START).count();
+}
+
+qint64 Tracer::getDroppedCount() {
+    QMutexLocker locker(&buffersMutex);
+    qint64 dropped = 0;
+    foreach(ThreadBuffer* buffer, buffers) dropped += buffer->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+//Setter methods
+void Tracer::setEnabled(bool enable) {enabled.store(enable, std::memory_order_relaxed);}
+
+/***IMPLEMENTING THE RECORDING METHODS FOR THE TRACER CLASS***/
+
+void Tracer::complete(const char* name, qint64 start, qint64 end) {record(name, Complete, start, end - start, 0);}
+void Tracer::instant(const char* name) {record(name, Instant, now(), 0, 0);}
+void Tracer::counter(const char* name, double value) {record(name, Counter, now(), 0, value);}
+
+/*  Purpose: Writes every recorded event to 'path' in the Chrome trace event format, with one track per thread. Should be called once
+    the traced threads are idle. Returns false if the file could not be written.*/
+bool Tracer::writeChromeTrace(QString path) {
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning("Unable to write the trace to %s", qPrintable(path));
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(3);
+    qint64 pid = QCoreApplication::applicationPid();
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    QMutexLocker locker(&buffersMutex);
+    bool first = true;
+    foreach(ThreadBuffer* buffer, buffers) {
+        if(!first) out << ",\n";
+        first = false;
+        QString threadName = buffer->threadName;
+        threadName.replace("\\", "\\\\").replace("\"", "\\\"");
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->threadIndex
+            << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+
+        //Chrome traces are in microseconds, the fractional part keeps the nanoseconds.
+        int count = buffer->count.load(std::memory_order_acquire);
+        for(int i=0;i<count;i++) {
+            const Event& event = buffer->events[i];
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"hrv\",\"pid\":" << pid << ",\"tid\":" << buffer->threadIndex
+                << ",\"ts\":" << event.timestamp / 1000.0;
+            if(event.phase == Complete) out << ",\"ph\":\"X\",\"dur\":" << event.duration / 1000.0 << "}";
+            else if(event.phase == Instant) out << ",\"ph\":\"i\",\"s\":\"t\"}";
+            else out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+        }
+    }
+    out << "\n]}\n";
+    return out.status() == QTextStream::Ok;
+}
+
+/***IMPLEMENTING THE HELPER METHODS FOR THE TRACER CLASS***/
+
+/*Purpose: Appends an event to the calling thread's buffer. Lock free except for the first event of each thread.*/
+void Tracer::record(const char* name, Phase phase, qint64 timestamp, qint64 duration, double value) {
+    ThreadBuffer* buffer = currentBuffer();
+    int index = buffer->count.load(std::memory_order_relaxed);
+    if(index >= BUFFER_CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = buffer->events[index];
+    event.name = name;
+    event.phase = phase;
+    event.timestamp = timestamp;
+    event.duration = duration;
+    event.value = value;
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+/*Purpose: Returns the calling thread's buffer, creating and registering it the first time the thread records an event.*/
+Tracer::ThreadBuffer* Tracer::currentBuffer() {
+    static thread_local ThreadBuffer* buffer = NULL;
+    if(buffer != NULL) return buffer;
+
+    buffer = new ThreadBuffer();
+    buffer->count.store(0, std::memory_order_relaxed);
+    buffer->dropped.store(0, std::memory_order_relaxed);
+    QThread* thread = QThread::currentThread();
+    if(QCoreApplication::instance() != NULL && thread == QCoreApplication::instance()->thread()) buffer->threadName = "GUI thread";
+    else if(!thread->objectName().isEmpty()) buffer->threadName = thread->objectName();
+    else buffer->threadName = QString("Worker %1").arg((quintptr) thread, 0, 16);
+
+    QMutexLocker locker(&buffersMutex);
+    buffer->threadIndex = buffers.size() + 1;
+    buffers.append(buffer);
+    return buffer;
+}
@@ -0,0 +1,95 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <atomic>
+
+/*  The Tracer class records a timeline of what the device does (Session ticks, sensor reads, coherence computations, beeps, button
+    presses, redraws and battery changes) and writes it as a Chrome trace (viewable in chrome://tracing or Perfetto).
+
+    Events are recorded with the HRV_TRACE_* macros below. They are only compiled in when HRV_TRACING is defined (CONFIG += tracing) and
+    even then only record while tracing is enabled at run time, so a disabled tracer costs one relaxed atomic load per event. Each thread
+    appends to its own fixed size buffer, so recording never takes a lock; a thread whose buffer is full drops its later events.
+*/
+class Tracer {
+
+    public:
+        static const int BUFFER_CAPACITY = 1 << 16;     //The number of events each thread can record.
+
+        //Getter methods
+        static bool isCompiledIn();
+        static bool isEnabled() {return enabled.load(std::memory_order_relaxed);}
+        static qint64 now();
+        static qint64 getDroppedCount();
+
+        //Setter methods
+        static void setEnabled(bool enable);
+
+        //Recording methods. 'name' must be a string literal (or otherwise outlive the Tracer), only the pointer is stored.
+        static void complete(const char* name, qint64 start, qint64 end);
+        static void instant(const char* name);
+        static void counter(const char* name, double value);
+
+        static bool writeChromeTrace(QString path);
+
+    private:
+        enum Phase {Complete, Instant, Counter};
+
+        struct Event {
+            const char* name;
+            qint64 timestamp;                           //Nanoseconds since the Tracer's clock started.
+            qint64 duration;                            //Complete events only.
+            double value;                               //Counter events only.
+            Phase phase;
+        };
+
+        //The events of one thread. Only the owning thread writes to it, and 'count' is published after each event is complete.
+        struct ThreadBuffer {
+            int threadIndex;
+            QString threadName;
+            Event events[BUFFER_CAPACITY];
+            std::atomic<int> count;
+            std::atomic<qint64> dropped;
+        };
+
+        static std::atomic<bool> enabled;
+        static QMutex buffersMutex;                     //Guards 'buffers', only taken when a thread records its first event.
+        static QVector<ThreadBuffer*> buffers;          //Every thread's buffer. Kept until exit so they can be exported.
+
+        //Helper methods
+        static void record(const char* name, Phase phase, qint64 timestamp, qint64 duration, double value);
+        static ThreadBuffer* currentBuffer();
+};
+
+/*Records the time from its construction to its destruction as one event.*/
+class TraceScope {
+
+    public:
+        TraceScope(const char* name) {
+            this->name = name;
+            this->start = Tracer::isEnabled() ? Tracer::now() : -1;
+        }
+        ~TraceScope() {
+            if(this->start >= 0) Tracer::complete(this->name, this->start, Tracer::now());
+        }
+
+    private:
+        const char* name;
+        qint64 start;                                   //-1 if tracing was disabled when the scope was entered.
+};
+
+#ifdef HRV_TRACING
+    #define HRV_TRACE_CONCAT_(a, b) a##b
+    #define HRV_TRACE_CONCAT(a, b) HRV_TRACE_CONCAT_(a, b)
+    #define HRV_TRACE_SCOPE(name) TraceScope HRV_TRACE_CONCAT(traceScope, __LINE__)(name)
+    #define HRV_TRACE_INSTANT(name) do { if(Tracer::isEnabled()) Tracer::instant(name); } while(0)
+    #define HRV_TRACE_COUNTER(name, value) do { if(Tracer::isEnabled()) Tracer::counter(name, value); } while(0)
+#else
+    #define HRV_TRACE_SCOPE(name) do {} while(0)
+    #define HRV_TRACE_INSTANT(name) do {} while(0)
+    #define HRV_TRACE_COUNTER(name, value) do {} while(0)
+#endif
+
+#endif // TRACER_H